@@ -1,12 +1,16 @@
 #include <ArgumentViewer/ArgumentViewer.h>
 #include <ArgumentViewer/Exception.h>
+#include <ArgumentViewer/Trace.h>
 #include <ArgumentViewer/private/ArgumentViewerImpl.h>
 #include <ArgumentViewer/private/ArgumentListFormat.h>
+#include <ArgumentViewer/private/Snapshot.h>
+#include <ArgumentViewer/private/ValueFormat.h>
 
 #include <MealyMachine/MealyMachine.h>
 #include <TxtUtils/TxtUtils.h>
 #include <algorithm>
 #include <cassert>
+#include <iomanip>
 #include <map>
 #include <set>
 #include <sstream>
@@ -25,18 +29,84 @@ using namespace argumentViewer;
  * @param argv list of arguments, it should always contain application name as
  * the first argument
  */
-ArgumentViewer::ArgumentViewer(int argc, char *argv[]) {
-  if (argc <= 0)
-    throw ex::Exception("number of arguments has to be greater than 0");
+ArgumentViewer::ArgumentViewer(int argc, char *argv[])
+    : ArgumentViewer(argc, argv, Settings()) {}
+
+/**
+ * @brief Contructor of ArgumentViewer with settings
+ * auto settings = Settings();
+ * settings.lazyIncludes = true;
+ * auto args = std::make_shared<ArgumentViewer>(argc,argv,settings);
+ *
+ * @param argc number of arguments, it should always be one or greater
+ * @param argv list of arguments, it should always contain application name as
+ * the first argument
+ * @param settings settings of argument reading
+ */
+ArgumentViewer::ArgumentViewer(int             argc,
+                               char *          argv[],
+                               Settings const &settings) {
   impl = std::unique_ptr<ArgumentViewerImpl>(new ArgumentViewerImpl);
   assert(impl != nullptr);
+  if (settings.trace) impl->trace = settings.trace->impl;
+  TraceSpan span(impl->trace.get(), "ArgumentViewer");
+  impl->format = std::make_shared<ArgumentListFormat>("");
+  impl->syntax = settings.syntax;
+  impl->missingFilesAreErrors = settings.missingFilesAreErrors;
+  impl->pathSeparator = settings.pathSeparator;
+  impl->fileCache =
+      std::make_shared<ArgumentFileCache>(settings.syntax, impl->trace);
+  if (argc <= 0) {
+    impl->raiseError(Error::WRONG_NUMBER_OF_ARGUMENTS,
+                     "number of arguments has to be greater than 0");
+    return;
+  }
   impl->applicationName = std::string(argv[0]);
-  std::vector<std::string> args;
-  for (int i = 1; i < argc; ++i) args.push_back(std::string(argv[i]));
-  std::set<std::string> alreadyLoaded;
-  impl->loadArgumentFiles(args, alreadyLoaded);
-  impl->arguments = args;
-  impl->format    = std::make_shared<ArgumentListFormat>("");
+  Tokens args;
+  // sub viewers are constructed without arguments, they do not need a source
+  std::shared_ptr<TokenSource> commandLine;
+  if (argc > 1) {
+    commandLine = std::make_shared<TokenSource>();
+    commandLine->positions.reserve(argc);
+  }
+  if (argc > 1 || hasLayers(settings.layers))
+    impl->inputGuard = std::make_shared<InputGuard>(settings.limits);
+  // terminator inside of context belongs to the context
+  size_t depth = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (depth == 0 && !settings.passthroughTerminator.empty() &&
+        settings.passthroughTerminator == argv[i]) {
+      impl->passthroughArguments.assign(argv + i + 1, argv + argc);
+      break;
+    }
+    auto const nofArgs = args.size();
+    if (settings.gnuOptions)
+      appendGnuArgument(args, argv[i], settings.syntax, settings.shortFlags);
+    else
+      args.emplace_back(argv[i], settings.syntax);
+    for (size_t j = nofArgs; j < args.size(); ++j) {
+      commandLine->positions.add(0, i);
+      if (args[j].kind == Token::CONTEXT_BEGIN) ++depth;
+      if (args[j].kind == Token::CONTEXT_END && depth > 0) --depth;
+    }
+  }
+  auto provenance = ProvenanceMap(commandLine, args.size());
+  if (hasLayers(settings.layers))
+    appendLayers(args, provenance, impl->commandLineLayerEnds, settings.layers,
+                 settings.syntax);
+  impl->commandLineArguments  = args;
+  impl->commandLineProvenance = provenance;
+  impl->layerEnds             = impl->commandLineLayerEnds;
+  // arguments over limits are not used at all
+  if (!impl->checkTokens(args) || !impl->checkNesting(args, 0)) return;
+  if (settings.lazyIncludes)
+    impl->deferArgumentFiles(args);
+  else {
+    impl->loadLayers(args, provenance, impl->layerEnds);
+    if (!impl->checkNesting(args, 0)) return;
+  }
+  impl->arguments  = args;
+  impl->provenance = std::move(provenance);
 }
 
 /**
@@ -72,8 +142,38 @@ size_t ArgumentViewer::getNofArguments() const {
  */
 std::string ArgumentViewer::getArgument(size_t const &index) const {
   assert(impl != nullptr);
+  impl->resolveAllIncludes();
+  assert(index < impl->arguments.size());
+  return impl->arguments.at(index).text;
+}
+
+/**
+ * @brief Returns layer of the value of argument, layers are set by
+ * Settings::layers
+ *
+ * @param argument name or path of argument
+ *
+ * @return layer of the first occurrence of argument, DEFAULT if it is not
+ * present
+ */
+Layers::Layer ArgumentViewer::getLayer(std::string const &argument) const {
+  assert(impl != nullptr);
+  return impl->getLayer(argument);
+}
+
+/**
+ * @brief Returns origin of argument - argument file, line and column
+ * or index of command line argument
+ *
+ * @param index index of argument
+ *
+ * @return origin of argument
+ */
+Provenance ArgumentViewer::getProvenance(size_t const &index) const {
+  assert(impl != nullptr);
+  impl->resolveAllIncludes();
   assert(index < impl->arguments.size());
-  return impl->arguments.at(index);
+  return impl->getProvenance(index);
 }
 
 /**
@@ -197,8 +297,7 @@ std::string ArgumentViewer::gets(std::string const &argument,
                                  std::string const &def,
                                  std::string const &com) const {
   assert(impl != nullptr);
-  return parseEscapeSequence(
-      impl->getArgumentWithFormat<std::string>(argument, def, com));
+  return impl->getArgumentWithFormat<std::string>(argument, def, com);
 }
 
 /**
@@ -316,6 +415,56 @@ std::shared_ptr<ArgumentViewer> ArgumentViewer::getContext(
   return impl->getContext(name,com,this);
 }
 
+/**
+ * @brief Returns arguments of context as argv of another program.
+ * Context is registered as forwarded, its arguments are not matched by
+ * validate(). Pointers point into arguments of this viewer, they are valid
+ * until this viewer is destroyed or reloaded.
+ *
+ * @param name context name or path of context
+ * @param comment comment
+ * @param programName argv[0], application name of this viewer if nullptr
+ *
+ * @return program name, arguments of context and nullptr
+ */
+std::vector<char *> ArgumentViewer::getContextArgv(std::string const &name,
+                                                   std::string const &com,
+                                                   char const *programName) const {
+  assert(impl != nullptr);
+  return impl->getContextArgv(name, com, programName);
+}
+
+/**
+ * @brief Returns range of arguments as argv of another program,
+ * pointers are valid until this viewer is destroyed or reloaded
+ *
+ * @param begin index of the first argument, see getArgument()
+ * @param end index after the last argument
+ * @param programName argv[0], application name of this viewer if nullptr
+ *
+ * @return program name, arguments and nullptr
+ */
+std::vector<char *> ArgumentViewer::getArgv(size_t begin, size_t end,
+                                            char const *programName) const {
+  assert(impl != nullptr);
+  return impl->getArgv(begin, end, programName);
+}
+
+/**
+ * @brief Returns command line arguments after Settings::passthroughTerminator
+ * as argv of another program, they are not matched by validate().
+ * Pointers are valid until this viewer is destroyed.
+ *
+ * @param programName argv[0], application name of this viewer if nullptr
+ *
+ * @return program name, arguments after terminator and nullptr
+ */
+std::vector<char *> ArgumentViewer::getPassthroughArgv(
+    char const *programName) const {
+  assert(impl != nullptr);
+  return impl->getPassthroughArgv(programName);
+}
+
 /**
  * @brief gets vector of string values
  *
@@ -333,10 +482,186 @@ std::vector<std::string> ArgumentViewer::getsv(
   return impl->getsv(argument,def,com);
 }
 
+/**
+ * @brief gets value of user type after argument, it is used by get<TYPE>
+ *
+ * @param argument argument name that has to be followed by value
+ * @param def default value, it also determines type and parser of value,
+ * it is copied only when the argument is registered
+ * @param comment comment
+ *
+ * @return next value after argument. if argument is not found, it returns
+ * nullptr and the default value should be used
+ */
+std::shared_ptr<Value const> ArgumentViewer::getValue(
+    std::string const &argument,
+    Value const &      def,
+    std::string const &com) const {
+  assert(impl != nullptr);
+  return impl->getValueWithFormat(argument, def, com);
+}
+
+/**
+ * @brief gets vector of values of user type after argument, it is used by
+ * getv<TYPE>
+ *
+ * @param argument argument name that has to be followed by values
+ * @param prototype value that determines type and parser of values
+ * @param def default values
+ * @param comment comment
+ *
+ * @return values after argument, it is padded by def
+ */
+std::vector<std::shared_ptr<Value const>> ArgumentViewer::getValues(
+    std::string const &                              argument,
+    std::shared_ptr<Value const> const &             prototype,
+    std::vector<std::shared_ptr<Value const>> const &def,
+    std::string const &                              com) const {
+  assert(impl != nullptr);
+  return impl->getValuesWithFormat(argument, prototype, def, com);
+}
+
 std::string ArgumentViewer::toStr() const {
   return impl->toStr();
 }
 
+/**
+ * @brief Returns size of memory that is needed by writeSnapshot
+ * All argument files are loaded.
+ *
+ * @return size of snapshot in bytes
+ */
+size_t ArgumentViewer::getSnapshotSize() const {
+  impl->resolveAllIncludes();
+  return ::getSnapshotSize(impl->applicationName, impl->arguments);
+}
+
+/**
+ * @brief Writes frozen arguments without pointers into memory.
+ * Snapshot can be read by SnapshotViewer, also by other processes.
+ *
+ * @param memory memory of getSnapshotSize() bytes aligned to 8 bytes
+ */
+void ArgumentViewer::writeSnapshot(void *memory) const {
+  impl->resolveAllIncludes();
+  ::writeSnapshot(memory, impl->applicationName, impl->arguments);
+}
+
+/**
+ * @brief Computes fingerprint of effective configuration.
+ * All registered arguments contribute by their values interpreted by their
+ * types, defaults are used for missing arguments and contexts are included
+ * recursively. So the fingerprint does not depend on order of arguments,
+ * on argument files or on the way the values are written ("1.0" and "1").
+ * Arguments are matched once like in diagnose(), unknown arguments are
+ * ignored. It can be called only on top level ArgumentViewer.
+ *
+ * @return 128 bit fingerprint
+ */
+Fingerprint ArgumentViewer::getFingerprint() const {
+  return impl->getFingerprint();
+}
+
+/**
+ * @brief Writes effective configuration for exact replay.
+ * Every registered argument is written with its effective value, defaults
+ * are written too and contexts are written recursively, present flags are
+ * written. Arguments are matched once like in diagnose(), unknown arguments
+ * are not written. Argument file does not depend on files that were loaded.
+ * Values with white space, "#" or empty values cannot be written into
+ * argument file (empty values equal to defaults are omitted),
+ * snapshot can contain any value.
+ * It can be called only on top level ArgumentViewer.
+ *
+ * @param stream output stream, it should be binary for snapshot
+ * @param format format of output
+ */
+void ArgumentViewer::writeConfiguration(std::ostream &      stream,
+                                        ConfigurationFormat format) const {
+  impl->writeConfiguration(stream, format);
+}
+
+std::string Fingerprint::toStr() const {
+  std::stringstream ss;
+  ss << std::hex << std::setfill('0') << std::setw(16) << high << std::setw(16)
+     << low;
+  return ss.str();
+}
+
 bool ArgumentViewer::validate() const {
   return impl->validate();
 }
+
+/**
+ * @brief Matches all arguments like validate() but it does not throw on
+ * wrong arguments, it collects all problems instead.
+ *
+ * @return list of problems, it is empty if arguments are valid
+ */
+std::vector<Diagnostic> ArgumentViewer::diagnose() const {
+  return impl->diagnose();
+}
+
+/**
+ * @brief Creates human readable message of diagnostic
+ *
+ * @param diagnostic diagnostic returned by diagnose()
+ *
+ * @return message
+ */
+std::string ArgumentViewer::getMessage(Diagnostic const &diagnostic) const {
+  return getDiagnosticMessage(diagnostic, impl->arguments, impl->syntax);
+}
+
+/**
+ * @brief Returns expected type of value of diagnostic
+ *
+ * @param diagnostic diagnostic returned by diagnose()
+ *
+ * @return type of value, empty if the problem is not about value
+ */
+std::string ArgumentViewer::getType(Diagnostic const &diagnostic) const {
+  return diagnostic.type;
+}
+
+/**
+ * @brief Reads again argument files that were modified since they were read.
+ * Files are checked by their modification time and size, unchanged files are
+ * not read again and files whose content did not change keep their
+ * tokenized arguments. The new arguments replace the old ones only after they are
+ * completely loaded, if loading fails, old arguments are kept.
+ * Lazily loaded files are all loaded by reload.
+ * It can be called only on top level ArgumentViewer.
+ * Arguments are replaced in place, reload must not run concurrently with any
+ * other method of this viewer or of its context viewers.
+ * Context viewers obtained before reload keep the old arguments, they have
+ * to be obtained again. If arguments changed, index of contexts and the last
+ * match are built again by the next lookup or validation.
+ *
+ * @return names of registered arguments whose values have changed,
+ * arguments inside contexts are prefixed by context names separated by
+ * Settings::pathSeparator, if paths are disabled, changed context is
+ * returned instead of its arguments
+ */
+std::vector<std::string> ArgumentViewer::reload() {
+  return impl->reload();
+}
+
+/**
+ * @brief Returns the first error that occurred since construction or the last
+ * clearError(). Errors are stored only if ArgumentViewer is built with
+ * ARGUMENTVIEWER_NO_EXCEPTIONS, otherwise they are thrown.
+ * Sub ArgumentViewers share errors with their parent.
+ *
+ * @return error, its code is Error::NONE if no error occurred
+ */
+Error ArgumentViewer::getError() const {
+  return *impl->error;
+}
+
+/**
+ * @brief Forgets stored error
+ */
+void ArgumentViewer::clearError() {
+  *impl->error = Error();
+}
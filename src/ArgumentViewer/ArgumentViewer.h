@@ -1,6 +1,12 @@
 #pragma once
 
+#include <ArgumentViewer/Diagnostic.h>
+#include <ArgumentViewer/Error.h>
+#include <ArgumentViewer/Fingerprint.h>
 #include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/Provenance.h>
+#include <ArgumentViewer/Settings.h>
+#include <ArgumentViewer/Value.h>
 #include <ArgumentViewer/argumentviewer_export.h>
 #include <iostream>
 #include <memory>
@@ -8,11 +14,22 @@
 
 class argumentViewer::ArgumentViewer {
  public:
+  enum ConfigurationFormat {
+    // argument file that can be loaded by "<"
+    ARGUMENT_FILE,
+    // snapshot that can be attached by SnapshotViewer
+    SNAPSHOT,
+  };
   ARGUMENTVIEWER_EXPORT ArgumentViewer(int argc, char* argv[]);
+  ARGUMENTVIEWER_EXPORT ArgumentViewer(int             argc,
+                                       char*           argv[],
+                                       Settings const& settings);
   ARGUMENTVIEWER_EXPORT ~ArgumentViewer();
   ARGUMENTVIEWER_EXPORT std::string                     getApplicationName() const;
   ARGUMENTVIEWER_EXPORT size_t                          getNofArguments() const;
   ARGUMENTVIEWER_EXPORT std::string                     getArgument(size_t const& index) const;
+  ARGUMENTVIEWER_EXPORT Provenance                      getProvenance(size_t const& index) const;
+  ARGUMENTVIEWER_EXPORT Layers::Layer                   getLayer(std::string const& argument) const;
   ARGUMENTVIEWER_EXPORT bool                            isPresent(std::string const& argument,
                                                                   std::string const& comment = "") const;
   ARGUMENTVIEWER_EXPORT float                           getf32(std::string const& argument,
@@ -57,13 +74,100 @@ class argumentViewer::ArgumentViewer {
   ARGUMENTVIEWER_EXPORT std::vector<std::string>        getsv(std::string const&              contextName,
                                                               std::vector<std::string> const& def = {},
                                                               std::string const& comment = "") const;
+  template <typename TYPE>
+  TYPE get(std::string const& argument,
+           TYPE const&        def     = TYPE(),
+           std::string const& comment = "") const;
+  template <typename TYPE>
+  std::vector<TYPE> getv(std::string const&       argument,
+                         std::vector<TYPE> const& def     = {},
+                         std::string const&       comment = "") const;
+  ARGUMENTVIEWER_EXPORT std::shared_ptr<Value const> getValue(
+      std::string const& argument,
+      Value const&       def,
+      std::string const& comment = "") const;
+  ARGUMENTVIEWER_EXPORT std::vector<std::shared_ptr<Value const>> getValues(
+      std::string const&                               argument,
+      std::shared_ptr<Value const> const&              prototype,
+      std::vector<std::shared_ptr<Value const>> const& def,
+      std::string const&                               comment = "") const;
   ARGUMENTVIEWER_EXPORT std::shared_ptr<ArgumentViewer> getContext(
       std::string const& name,
       std::string const& comment = "") const;
+  ARGUMENTVIEWER_EXPORT std::vector<char*> getContextArgv(
+      std::string const& name,
+      std::string const& comment     = "",
+      char const*        programName = nullptr) const;
+  ARGUMENTVIEWER_EXPORT std::vector<char*> getArgv(
+      size_t      begin,
+      size_t      end,
+      char const* programName = nullptr) const;
+  ARGUMENTVIEWER_EXPORT std::vector<char*> getPassthroughArgv(
+      char const* programName = nullptr) const;
   ARGUMENTVIEWER_EXPORT bool        validate() const;
+  ARGUMENTVIEWER_EXPORT std::vector<Diagnostic> diagnose() const;
+  ARGUMENTVIEWER_EXPORT std::string getMessage(Diagnostic const& diagnostic) const;
+  ARGUMENTVIEWER_EXPORT std::string getType(Diagnostic const& diagnostic) const;
+  ARGUMENTVIEWER_EXPORT std::vector<std::string> reload();
+  ARGUMENTVIEWER_EXPORT Error       getError() const;
+  ARGUMENTVIEWER_EXPORT void        clearError();
   ARGUMENTVIEWER_EXPORT std::string toStr() const;
+  ARGUMENTVIEWER_EXPORT size_t      getSnapshotSize() const;
+  ARGUMENTVIEWER_EXPORT void        writeSnapshot(void* memory) const;
+  ARGUMENTVIEWER_EXPORT Fingerprint getFingerprint() const;
+  ARGUMENTVIEWER_EXPORT void        writeConfiguration(std::ostream&       stream,
+                                                       ConfigurationFormat format = ARGUMENT_FILE) const;
 
  protected:
   std::unique_ptr<ArgumentViewerImpl> impl;
   friend class ArgumentViewerImpl;
+  friend class PushMatcher;
+  friend class Sweep;
+  friend class Batch;
 };
+
+/**
+ * @brief gets value of user type after argument.
+ * TYPE has to have specialization of argumentViewer::ValueTraits.
+ *
+ * @param argument argument name that has to be followed by value of TYPE
+ * @param def default value
+ * @param comment comment
+ *
+ * @return next value after argument. if argument is not found, it returns def
+ */
+template <typename TYPE>
+TYPE argumentViewer::ArgumentViewer::get(std::string const& argument,
+                                         TYPE const&        def,
+                                         std::string const& comment) const
+{
+  auto const value = getValue(argument, TypedValue<TYPE>(def), comment);
+  if (!value) return def;
+  return static_cast<TypedValue<TYPE> const&>(*value).value;
+}
+
+/**
+ * @brief gets vector of values of user type after argument.
+ * TYPE has to have specialization of argumentViewer::ValueTraits.
+ *
+ * @param argument argument name that has to be followed by values of TYPE
+ * @param def default values
+ * @param comment comment
+ *
+ * @return values after argument, it is padded by def
+ */
+template <typename TYPE>
+std::vector<TYPE> argumentViewer::ArgumentViewer::getv(
+    std::string const&       argument,
+    std::vector<TYPE> const& def,
+    std::string const&       comment) const
+{
+  std::vector<std::shared_ptr<Value const>> defs;
+  for (auto const& x : def) defs.push_back(std::make_shared<TypedValue<TYPE>>(x));
+  auto const values = getValues(
+      argument, std::make_shared<TypedValue<TYPE>>(), defs, comment);
+  std::vector<TYPE> result;
+  for (auto const& x : values)
+    result.push_back(static_cast<TypedValue<TYPE> const&>(*x).value);
+  return result;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <ArgumentViewer/ArgumentViewer.h>
+#include <ArgumentViewer/Syntax.h>
+
+namespace argumentViewer {
+/**
+ * @brief ArgumentViewer with delimiters given by syntax policy
+ * auto args = std::make_shared<BasicArgumentViewer<ShellSyntax>>(argc,argv);
+ * Arguments are classified once when they are read, lookups and validation
+ * compare classified kinds, so the syntax does not cost anything later.
+ */
+template <typename SYNTAX>
+class BasicArgumentViewer : public ArgumentViewer {
+ public:
+  BasicArgumentViewer(int argc, char* argv[], Settings settings = Settings())
+      : ArgumentViewer(argc, argv, withSyntax(settings))
+  {
+  }
+
+ private:
+  static Settings const& withSyntax(Settings& settings)
+  {
+    settings.syntax = toSyntax<SYNTAX>();
+    return settings;
+  }
+};
+}  // namespace argumentViewer
@@ -0,0 +1,178 @@
+#include <ArgumentViewer/ArgumentViewer.h>
+#include <ArgumentViewer/Batch.h>
+#include <ArgumentViewer/private/ArgumentViewerImpl.h>
+#include <ArgumentViewer/private/BatchData.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <thread>
+
+using namespace argumentViewer;
+
+size_t const BatchData::blockSize;
+
+namespace {
+/**
+ * @brief Splits line by white space, # starts comment like in argument files
+ */
+void splitLineToArguments(Tokens &tokens, string const &line, Syntax const &syntax)
+{
+  size_t       begin = 0;
+  size_t const end   = min(line.find('#'), line.length());
+  while (true) {
+    begin = line.find_first_not_of(" \t\r\n", begin);
+    if (begin >= end) return;
+    auto const wordEnd = min(line.find_first_of(" \t\r\n", begin), end);
+    tokens.emplace_back(line.substr(begin, wordEnd - begin), syntax);
+    begin = wordEnd;
+  }
+}
+
+void parseLine(BatchData const &data, string const &line, BatchLine &result)
+{
+  Tokens tokens;
+  splitLineToArguments(tokens, line, data.syntax);
+  size_t index = 0;
+  data.format->match(tokens, index, result.diagnostics);
+  result.arguments.reserve(tokens.size());
+  for (auto &token : tokens) result.arguments.push_back(std::move(token.text));
+  for (auto const &diagnostic : result.diagnostics)
+    result.messages.push_back(getDiagnosticMessage(diagnostic, tokens, data.syntax));
+}
+
+/**
+ * @brief Parses line, exception does not leave thread of pool
+ */
+void tryParseLine(BatchData const &data, string const &line, BatchLine &result)
+{
+#if defined(ARGUMENTVIEWER_NO_EXCEPTIONS)
+  parseLine(data, line, result);
+#else
+  try {
+    parseLine(data, line, result);
+  } catch (std::exception const &e) {
+    result.error = e.what();
+  } catch (...) {
+    result.error = "unknown exception";
+  }
+#endif
+}
+
+/**
+ * @brief Starts threads of pool, it stops at the first thread that cannot be
+ * started, remaining blocks are parsed by started threads
+ */
+template <typename FUNCTION>
+void startThreads(std::vector<std::thread> &threads,
+                  size_t                    nofThreads,
+                  FUNCTION const &          function)
+{
+#if defined(ARGUMENTVIEWER_NO_EXCEPTIONS)
+  threads.reserve(nofThreads);
+  for (size_t i = 0; i < nofThreads; ++i) threads.emplace_back(function);
+#else
+  try {
+    threads.reserve(nofThreads);
+    for (size_t i = 0; i < nofThreads; ++i) threads.emplace_back(function);
+  } catch (std::exception const &) {
+  }
+#endif
+}
+}  // namespace
+
+/**
+ * @brief Creates batch parser of arguments registered in viewer
+ *
+ * @param viewer viewer with registered arguments, it can be sub viewer
+ * @param nofThreads number of threads, 0 for number of cores
+ */
+Batch::Batch(ArgumentViewer const &viewer, size_t nofThreads)
+{
+  assert(viewer.impl != nullptr);
+  auto batchData    = std::make_shared<BatchData>();
+  batchData->format = formatCast<ArgumentListFormat>(viewer.impl->format);
+  batchData->syntax = viewer.impl->syntax;
+  batchData->error  = viewer.impl->error;
+  if (nofThreads == 0) nofThreads = std::thread::hardware_concurrency();
+  batchData->nofThreads = std::max<size_t>(nofThreads, 1);
+  data                  = batchData;
+}
+
+/**
+ * @brief Parses every line of job file
+ *
+ * @param fileName name of job file
+ *
+ * @return arguments of lines, empty if file cannot be read
+ */
+std::vector<BatchLine> Batch::parseFile(std::string const &fileName) const
+{
+  std::ifstream file(fileName);
+  if (!file.is_open()) {
+    raiseError(*data->error, Error::FILE_NOT_FOUND,
+               std::string("file: ") + fileName + " cannot be loaded");
+    return {};
+  }
+  std::vector<std::string> lines;
+  std::string              line;
+  while (std::getline(file, line)) lines.push_back(std::move(line));
+  return parseLines(lines);
+}
+
+/**
+ * @brief Parses every line
+ *
+ * @param lines command lines without application name
+ *
+ * @return arguments of lines
+ */
+std::vector<BatchLine> Batch::parseLines(
+    std::vector<std::string> const &lines) const
+{
+  return parseLines(lines.data(), lines.size());
+}
+
+/**
+ * @brief Parses span of lines
+ *
+ * @param lines command lines without application name
+ * @param nofLines number of lines
+ * @param firstLine number of the first line in results
+ *
+ * @return arguments of lines
+ */
+std::vector<BatchLine> Batch::parseLines(std::string const *lines,
+                                         size_t             nofLines,
+                                         size_t             firstLine) const
+{
+  std::vector<BatchLine> results(nofLines);
+  std::atomic<size_t>    nextBlock(0);
+  auto const             parseBlocks = [&] {
+    while (true) {
+      size_t const begin = nextBlock.fetch_add(BatchData::blockSize);
+      if (begin >= nofLines) return;
+      size_t const end = std::min(begin + BatchData::blockSize, nofLines);
+      for (size_t i = begin; i < end; ++i) {
+        results[i].line = firstLine + i;
+        tryParseLine(*data, lines[i], results[i]);
+      }
+    }
+  };
+  size_t const nofBlocks =
+      (nofLines + BatchData::blockSize - 1) / BatchData::blockSize;
+  std::vector<std::thread> threads;
+  size_t const             nofPoolThreads = std::min(data->nofThreads, nofBlocks);
+  // calling thread is one of the pool
+  if (nofPoolThreads > 1) startThreads(threads, nofPoolThreads - 1, parseBlocks);
+  parseBlocks();
+  for (auto &thread : threads) thread.join();
+  // lines without arguments are not jobs
+  results.erase(std::remove_if(results.begin(), results.end(),
+                               [](BatchLine const &result) {
+                                 return result.arguments.empty() &&
+                                        result.error.empty();
+                               }),
+                results.end());
+  return results;
+}
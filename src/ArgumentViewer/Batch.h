@@ -0,0 +1,52 @@
+#pragma once
+
+#include <ArgumentViewer/Diagnostic.h>
+#include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/argumentviewer_export.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Arguments of one line of job file
+ */
+struct argumentViewer::BatchLine {
+  // number of line, the first line is 1
+  size_t                   line = 0;
+  std::vector<std::string> arguments;
+  std::vector<Diagnostic>  diagnostics;
+  // messages of diagnostics
+  std::vector<std::string> messages;
+  // message of exception thrown while line was parsed, empty if there was none
+  std::string error;
+};
+
+/**
+ * @brief Parsing of job files, every line is one command line.
+ * Lines are matched by arguments registered in ArgumentViewer, threads of
+ * a pool share the registered arguments and take blocks of lines.
+ * Results are in order of lines, lines without arguments are skipped.
+ * Exception thrown while a line is parsed (e.g. by a user value) is stored
+ * in error of the line, other lines are parsed.
+ * Lines do not include argument files. Arguments must not be registered
+ * while lines are parsed.
+ * auto batch = Batch(*args);
+ * for(auto const&job:batch.parseFile("jobs.txt"))
+ *   if(!job.diagnostics.empty())std::cerr<<job.line<<": "<<job.messages[0];
+ */
+class argumentViewer::Batch {
+ public:
+  ARGUMENTVIEWER_EXPORT Batch(ArgumentViewer const& viewer,
+                              size_t                nofThreads = 0);
+  ARGUMENTVIEWER_EXPORT std::vector<BatchLine> parseFile(
+      std::string const& fileName) const;
+  ARGUMENTVIEWER_EXPORT std::vector<BatchLine> parseLines(
+      std::vector<std::string> const& lines) const;
+  ARGUMENTVIEWER_EXPORT std::vector<BatchLine> parseLines(
+      std::string const* lines,
+      size_t             nofLines,
+      size_t             firstLine = 1) const;
+
+ private:
+  std::shared_ptr<BatchData const> data;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Problem found in arguments by ArgumentViewer::diagnose
+ * Message is not stored, it can be created by ArgumentViewer::getMessage
+ */
+struct argumentViewer::Diagnostic {
+  enum Kind {
+    // argument cannot be matched by any registered argument
+    UNKNOWN_ARGUMENT,
+    // value argument is followed by end of arguments
+    MISSING_VALUE,
+    // value argument is followed by value of different type
+    INCOMPATIBLE_VALUE,
+    // context argument is not followed by context begin
+    MISSING_CONTEXT_BEGIN,
+    // context is not ended by context end
+    MISSING_CONTEXT_END,
+  };
+  Kind kind;
+  // index of argument where the problem was found
+  size_t index;
+  // index of argument name the problem belongs to
+  size_t argumentIndex;
+  // type of value expected by the argument, empty if the problem is not
+  // about value
+  std::string type;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <string>
+
+/**
+ * @brief Error of ArgumentViewer.
+ * If ArgumentViewer is built with exceptions, errors are thrown as
+ * ex::Exception or ex::MatchError.
+ * If it is built with ARGUMENTVIEWER_NO_EXCEPTIONS, the first error is stored
+ * and it can be obtained by ArgumentViewer::getError().
+ */
+struct argumentViewer::Error {
+  enum Code {
+    // there is no error
+    NONE,
+    // number of arguments is not greater than 0
+    WRONG_NUMBER_OF_ARGUMENTS,
+    // argument is already defined with different type or default values
+    INCOMPATIBLE_DEFINITION,
+    // file symbol is not followed by filename
+    MISSING_FILE_NAME,
+    // file is included by itself
+    FILE_LOADING_LOOP,
+    // file cannot be read
+    FILE_NOT_FOUND,
+    // operation cannot be run on sub ArgumentViewer
+    SUB_VIEWER_OPERATION,
+    // arguments cannot be matched
+    MATCH_ERROR,
+    // value cannot be written into argument file
+    UNREPRESENTABLE_VALUE,
+    // arguments exceed Settings::limits
+    LIMIT_EXCEEDED,
+    // JSON argument file is not valid
+    INVALID_JSON,
+  };
+  Code        code = NONE;
+  std::string message;
+};
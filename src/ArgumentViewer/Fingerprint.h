@@ -0,0 +1,23 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/argumentviewer_export.h>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 128 bit digest of effective configuration.
+ * It can be used as a key of cached results.
+ * It is not cryptographic, it must not be used against malicious inputs.
+ */
+struct argumentViewer::Fingerprint {
+  uint64_t low  = 0;
+  uint64_t high = 0;
+  bool     operator==(Fingerprint const& other) const
+  {
+    return low == other.low && high == other.high;
+  }
+  bool operator!=(Fingerprint const& other) const { return !(*this == other); }
+  // 32 hexadecimal digits, higher bits first
+  ARGUMENTVIEWER_EXPORT std::string toStr() const;
+};
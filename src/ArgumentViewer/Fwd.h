@@ -3,6 +3,29 @@
 namespace argumentViewer{
   class ArgumentViewer;
   class ArgumentViewerImpl;
+  struct Settings;
+  struct Syntax;
+  struct Limits;
+  struct Layers;
+  struct Fingerprint;
+  struct Provenance;
+  class Trace;
+  class TraceImpl;
+  struct Diagnostic;
+  struct Error;
+  class Value;
+  class SnapshotViewer;
+  class SharedSnapshot;
+  class PushMatcher;
+  class PushMatcherImpl;
+  struct PushState;
+  class Sweep;
+  class SweepView;
+  struct SweepData;
+  struct SweepChoices;
+  class Batch;
+  struct BatchLine;
+  struct BatchData;
   namespace ex{
     class Exception;
     class MatchError;
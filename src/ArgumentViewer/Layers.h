@@ -0,0 +1,43 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Sources of arguments with lower priority than command line.
+ * Arguments are ordered by layers: command line, environment variables and
+ * files in their order. The first occurrence of argument wins, so every
+ * lookup is one probe of the index of arguments. An argument can repeat in
+ * a lower layer, validate() accepts it. Contexts are not merged, context of
+ * a higher layer hides the whole context of a lower one.
+ * auto settings = Settings();
+ * settings.layers.files             = {"/etc/app/site.txt"};
+ * settings.layers.environmentPrefix = "APP_";
+ * //APP_LIGHT_INTENSITY=2 is read as --light-intensity 2
+ */
+struct argumentViewer::Layers {
+  enum Layer {
+    // argument is not present, default value is used
+    DEFAULT,
+    FILE,
+    ENVIRONMENT,
+    COMMAND_LINE,
+  };
+  /**
+   * @brief Argument files, every file is a layer, earlier files win
+   */
+  std::vector<std::string> files;
+  /**
+   * @brief Prefix of environment variables that are read, empty prefix
+   * disables environment. Value of variable is split by white space.
+   */
+  std::string environmentPrefix;
+  /**
+   * @brief Maps name of environment variable without prefix to argument name,
+   * empty name skips the variable.
+   * By default, LIGHT_INTENSITY is mapped to --light-intensity.
+   */
+  std::function<std::string(std::string const &)> environmentRule;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <cstddef>
+#include <limits>
+
+/**
+ * @brief Limits of arguments read from untrusted input.
+ * Exceeding a limit raises Error::LIMIT_EXCEEDED while arguments are read,
+ * before they are matched. Everything is unlimited by default.
+ * auto settings = Settings();
+ * settings.limits.maxNestingDepth = 16;
+ * settings.limits.maxBytes        = 1 << 20;
+ */
+struct argumentViewer::Limits {
+  static size_t const unlimited = std::numeric_limits<size_t>::max();
+  /**
+   * @brief Maximal number of tokens of command line and all included files,
+   * a file included several times is counted several times.
+   */
+  size_t maxTokens = unlimited;
+  /**
+   * @brief Maximal number of nested contexts
+   */
+  size_t maxNestingDepth = unlimited;
+  /**
+   * @brief Maximal depth of files included by files,
+   * file included from command line has depth 1
+   */
+  size_t maxIncludeDepth = unlimited;
+  /**
+   * @brief Maximal number of included files
+   */
+  size_t maxIncludes = unlimited;
+  /**
+   * @brief Maximal number of bytes of all included files,
+   * it is checked while files are read, reading stops at the limit
+   */
+  size_t maxBytes = unlimited;
+  /**
+   * @brief Maximal length of one token
+   */
+  size_t maxTokenLength = unlimited;
+};
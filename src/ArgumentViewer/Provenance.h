@@ -0,0 +1,19 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Origin of an argument.
+ * Arguments of argument files have name of the file, line and column
+ * starting from 1. Command line arguments have empty file, line 0
+ * and column equal to their index in argv. Arguments of environment
+ * variables have name of variable as file, line 0 and column equal to
+ * their index in the variable, the argument name has column 0.
+ */
+struct argumentViewer::Provenance {
+  std::string file;
+  size_t      line   = 0;
+  size_t      column = 0;
+};
@@ -0,0 +1,47 @@
+#include <ArgumentViewer/ArgumentViewer.h>
+#include <ArgumentViewer/PushMatcher.h>
+#include <ArgumentViewer/private/ArgumentViewerImpl.h>
+#include <ArgumentViewer/private/PushMatcherImpl.h>
+
+using namespace argumentViewer;
+
+/**
+ * @brief Creates matcher of arguments registered in viewer
+ *
+ * @param viewer viewer with registered arguments, it can be sub viewer
+ */
+PushMatcher::PushMatcher(ArgumentViewer const &viewer)
+    : impl(new PushMatcherImpl)
+{
+  impl->root   = viewer.impl->format;
+  impl->syntax = viewer.impl->syntax;
+  impl->reset();
+}
+
+PushMatcher::~PushMatcher() {}
+
+/**
+ * @brief Matches next token
+ *
+ * @param token token, delimiters are read by syntax of viewer
+ *
+ * @return state after the token
+ */
+PushState PushMatcher::push(std::string const &token)
+{
+  impl->push(Token(token, impl->syntax));
+  return impl->getState();
+}
+
+/**
+ * @brief Returns state after the last token, without tokens it returns
+ * arguments that can be at the beginning
+ *
+ * @return state
+ */
+PushState PushMatcher::getState() const { return impl->getState(); }
+
+/**
+ * @brief Forgets all tokens
+ */
+void PushMatcher::reset() { impl->reset(); }
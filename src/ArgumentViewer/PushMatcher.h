@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/argumentviewer_export.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief State of PushMatcher after a token
+ */
+struct argumentViewer::PushState {
+  enum Status {
+    // token was matched
+    ACCEPTED,
+    // token is not registered argument or it is in block of unknown argument
+    UNKNOWN_ARGUMENT,
+    // token is not value of expected type
+    INCOMPATIBLE_VALUE,
+    // context or string vector argument is not followed by context begin
+    MISSING_CONTEXT_BEGIN,
+  };
+  Status status = ACCEPTED;
+  // names of open contexts, the innermost is the last one
+  std::vector<std::string> contexts;
+  // type of value that can follow, empty if no value can follow
+  std::string expectedType;
+  // true if the next token has to be value of expectedType
+  bool valueRequired = false;
+  // registered arguments and delimiters that can follow
+  std::vector<std::string> nextArguments;
+  // true if arguments can end here without missing value or context end
+  bool complete = true;
+};
+
+/**
+ * @brief Matcher that accepts one token at a time.
+ * It uses arguments registered in ArgumentViewer, arguments that are
+ * registered later are used too.
+ * auto matcher = std::make_shared<PushMatcher>(*args);
+ * for(auto const&token:typedTokens)state = matcher->push(token);
+ */
+class argumentViewer::PushMatcher {
+ public:
+  ARGUMENTVIEWER_EXPORT PushMatcher(ArgumentViewer const& viewer);
+  ARGUMENTVIEWER_EXPORT ~PushMatcher();
+  ARGUMENTVIEWER_EXPORT PushState push(std::string const& token);
+  ARGUMENTVIEWER_EXPORT PushState getState() const;
+  ARGUMENTVIEWER_EXPORT void      reset();
+
+ protected:
+  std::unique_ptr<PushMatcherImpl> impl;
+};
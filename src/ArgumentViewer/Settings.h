@@ -0,0 +1,71 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/Layers.h>
+#include <ArgumentViewer/Limits.h>
+#include <ArgumentViewer/Syntax.h>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Settings that alter how ArgumentViewer reads its arguments
+ */
+struct argumentViewer::Settings {
+  /**
+   * @brief If true, files included by "<" are loaded only when a lookup or
+   * validate() needs to look past them.
+   * Every included file has to contain balanced context brackets.
+   */
+  bool lazyIncludes = false;
+  /**
+   * @brief If true, file included by "<" that does not exist raises
+   * FILE_NOT_FOUND, otherwise it is included as empty file.
+   */
+  bool missingFilesAreErrors = false;
+  /**
+   * @brief If true, command line arguments --key=value are read as --key value
+   * and bundled short flags -vq are read as -v -q.
+   * Arguments in files are not split.
+   */
+  bool gnuOptions = false;
+  /**
+   * @brief Letters of short flags that can be bundled when gnuOptions is set.
+   * -vq is split only if both v and q are listed, so values like -inf or
+   * -foo are kept. Empty string splits nothing.
+   */
+  std::string shortFlags;
+  /**
+   * @brief Delimiters of contexts and included files,
+   * BasicArgumentViewer sets them from its syntax policy.
+   */
+  Syntax syntax;
+  /**
+   * @brief Separator of contexts in names of read arguments, e.g. '/'.
+   * geti32v("light/info/sampling") then reads sampling of context info of
+   * context light without constructing context viewers.
+   * Zero, the default, disables paths and names are read as they are.
+   */
+  char pathSeparator = 0;
+  /**
+   * @brief Limits of read arguments, files and contexts,
+   * they should be set when arguments come from untrusted input.
+   */
+  Limits limits;
+  /**
+   * @brief Environment variables and argument files with lower priority than
+   * command line
+   */
+  Layers layers;
+  /**
+   * @brief Command line argument that ends arguments of this program,
+   * following arguments are not matched and getPassthroughArgv() returns
+   * them. Terminator inside of a context is an argument of the context.
+   * Empty terminator is disabled, it is disabled by default.
+   */
+  std::string passthroughTerminator = "";
+  /**
+   * @brief If set, spans of work are recorded into the trace.
+   * Context viewers record into the trace of their parent.
+   */
+  std::shared_ptr<Trace> trace;
+};
@@ -0,0 +1,118 @@
+#include <ArgumentViewer/ArgumentViewer.h>
+#include <ArgumentViewer/SharedSnapshot.h>
+#include <ArgumentViewer/SnapshotViewer.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ARGUMENTVIEWER_SHARED_MEMORY
+#endif
+
+using namespace argumentViewer;
+
+SharedSnapshot::SharedSnapshot(void * d,
+                               size_t s,
+                               int    fd,
+                               bool   o)
+    : data(d), size(s), fileDescriptor(fd), owner(o)
+{
+}
+
+#if defined(ARGUMENTVIEWER_SHARED_MEMORY)
+namespace {
+int createSharedFile(size_t size)
+{
+#if defined(__linux__)
+  int const fd = memfd_create("ArgumentViewer", 0);
+  if (fd < 0) return -1;
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+#else
+  (void)size;
+  return -1;
+#endif
+}
+
+void *mapMemory(size_t size, int fd, int protection)
+{
+  int const flags = fd < 0 ? MAP_SHARED | MAP_ANON : MAP_SHARED;
+  void *    data  = mmap(nullptr, size, protection, flags, fd, 0);
+  if (data == MAP_FAILED) return nullptr;
+  return data;
+}
+}  // namespace
+#endif
+
+/**
+ * @brief Writes frozen arguments into new shared memory that is read-only
+ *
+ * @param arguments arguments, all argument files are loaded
+ *
+ * @return shared memory or nullptr if it cannot be created
+ */
+std::shared_ptr<SharedSnapshot> SharedSnapshot::publish(
+    ArgumentViewer const &arguments)
+{
+#if defined(ARGUMENTVIEWER_SHARED_MEMORY)
+  size_t const size = arguments.getSnapshotSize();
+  int const    fd   = createSharedFile(size);
+  void *const  data = mapMemory(size, fd, PROT_READ | PROT_WRITE);
+  if (data == nullptr) {
+    if (fd >= 0) close(fd);
+    return nullptr;
+  }
+  arguments.writeSnapshot(data);
+  mprotect(data, size, PROT_READ);
+  return std::shared_ptr<SharedSnapshot>(
+      new SharedSnapshot(data, size, fd, true));
+#else
+  (void)arguments;
+  return nullptr;
+#endif
+}
+
+/**
+ * @brief Maps shared memory published by other process
+ *
+ * @param fileDescriptor file descriptor of SharedSnapshot::publish
+ *
+ * @return read-only shared memory or nullptr if it cannot be mapped
+ */
+std::shared_ptr<SharedSnapshot> SharedSnapshot::open(int fileDescriptor)
+{
+#if defined(ARGUMENTVIEWER_SHARED_MEMORY)
+  struct stat info;
+  if (fstat(fileDescriptor, &info) != 0 || info.st_size <= 0) return nullptr;
+  size_t const size = static_cast<size_t>(info.st_size);
+  void *const  data = mapMemory(size, fileDescriptor, PROT_READ);
+  if (data == nullptr) return nullptr;
+  return std::shared_ptr<SharedSnapshot>(
+      new SharedSnapshot(data, size, fileDescriptor, false));
+#else
+  (void)fileDescriptor;
+  return nullptr;
+#endif
+}
+
+SharedSnapshot::~SharedSnapshot()
+{
+#if defined(ARGUMENTVIEWER_SHARED_MEMORY)
+  munmap(data, size);
+  if (owner && fileDescriptor >= 0) close(fileDescriptor);
+#endif
+}
+
+void const *SharedSnapshot::getData() const { return data; }
+
+size_t SharedSnapshot::getSize() const { return size; }
+
+int SharedSnapshot::getFileDescriptor() const { return fileDescriptor; }
+
+std::shared_ptr<SnapshotViewer> SharedSnapshot::getViewer() const
+{
+  return SnapshotViewer::attach(data, size);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/argumentviewer_export.h>
+#include <cstddef>
+#include <memory>
+
+/**
+ * @brief Frozen arguments in read-only shared memory.
+ * Memory is mapped before workers are forked, so all workers read the same
+ * pages. On Linux the memory is a memfd, its file descriptor can be passed
+ * to workers that are started by exec and they can map it by open().
+ * Shared memory is not supported on other platforms, publish returns nullptr.
+ */
+class argumentViewer::SharedSnapshot {
+ public:
+  ARGUMENTVIEWER_EXPORT static std::shared_ptr<SharedSnapshot> publish(
+      ArgumentViewer const& arguments);
+  ARGUMENTVIEWER_EXPORT static std::shared_ptr<SharedSnapshot> open(
+      int fileDescriptor);
+  ARGUMENTVIEWER_EXPORT ~SharedSnapshot();
+  ARGUMENTVIEWER_EXPORT void const* getData() const;
+  ARGUMENTVIEWER_EXPORT size_t      getSize() const;
+  ARGUMENTVIEWER_EXPORT int         getFileDescriptor() const;
+  // returned viewer can be used only while this snapshot exists
+  ARGUMENTVIEWER_EXPORT std::shared_ptr<SnapshotViewer> getViewer() const;
+
+ private:
+  SharedSnapshot(void* data, size_t size, int fileDescriptor, bool owner);
+  void*  data;
+  size_t size;
+  int    fileDescriptor;
+  bool   owner;
+};
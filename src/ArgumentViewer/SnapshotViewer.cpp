@@ -0,0 +1,186 @@
+#include <ArgumentViewer/SnapshotViewer.h>
+#include <ArgumentViewer/private/ArgumentReader.h>
+#include <ArgumentViewer/private/Snapshot.h>
+#include <cassert>
+#include <cstring>
+
+using namespace argumentViewer;
+
+namespace {
+SnapshotHeader const &getHeader(char const *data)
+{
+  return *reinterpret_cast<SnapshotHeader const *>(data);
+}
+
+SnapshotToken const &getToken(char const *data, size_t index)
+{
+  return reinterpret_cast<SnapshotToken const *>(
+      data + sizeof(SnapshotHeader))[index];
+}
+
+struct SnapshotSource {
+  char const *data;
+  Token::Kind getKind(size_t index) const
+  {
+    return static_cast<Token::Kind>(getToken(data, index).kind);
+  }
+  bool isEqual(size_t index, string const &text) const
+  {
+    auto const &token = getToken(data, index);
+    return token.length == text.length() &&
+           memcmp(data + token.offset, text.data(), text.length()) == 0;
+  }
+  string getValue(size_t index) const
+  {
+    auto const &token = getToken(data, index);
+    if (token.kind == Token::ESCAPED_VALUE)
+      return string(data + token.offset + 1, token.length - 1);
+    return string(data + token.offset, token.length);
+  }
+  size_t getClosing(size_t index) const { return getToken(data, index).closing; }
+};
+}  // namespace
+
+/**
+ * @brief Attaches viewer to frozen arguments
+ *
+ * @param data memory with snapshot written by ArgumentViewer::writeSnapshot
+ * @param size size of memory
+ *
+ * @return viewer of all arguments or nullptr if memory does not contain
+ * valid snapshot
+ */
+std::shared_ptr<SnapshotViewer> SnapshotViewer::attach(void const *data,
+                                                       size_t      size)
+{
+  if (!isSnapshotValid(data, size)) return nullptr;
+  auto const bytes = static_cast<char const *>(data);
+  return std::shared_ptr<SnapshotViewer>(
+      new SnapshotViewer(bytes, 0, getHeader(bytes).nofTokens));
+}
+
+SnapshotViewer::SnapshotViewer(char const *d, size_t b, size_t e)
+    : data(d), begin(b), end(e)
+{
+}
+
+std::string SnapshotViewer::getApplicationName() const
+{
+  auto const &header = getHeader(data);
+  return std::string(data + header.applicationNameOffset,
+                     header.applicationNameLength);
+}
+
+size_t SnapshotViewer::getNofArguments() const { return end - begin; }
+
+std::string SnapshotViewer::getArgument(size_t const &index) const
+{
+  assert(index < getNofArguments());
+  auto const &token = getToken(data, begin + index);
+  return std::string(data + token.offset, token.length);
+}
+
+bool SnapshotViewer::isPresent(std::string const &argument) const
+{
+  return findArgument(SnapshotSource{data}, begin, end, argument) < end;
+}
+
+float SnapshotViewer::getf32(std::string const &argument,
+                             float const &      def) const
+{
+  return readValue<float>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+double SnapshotViewer::getf64(std::string const &argument,
+                              double const &     def) const
+{
+  return readValue<double>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+int32_t SnapshotViewer::geti32(std::string const &argument,
+                               int32_t const &    def) const
+{
+  return readValue<int32_t>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+int64_t SnapshotViewer::geti64(std::string const &argument,
+                               int64_t const &    def) const
+{
+  return readValue<int64_t>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+uint32_t SnapshotViewer::getu32(std::string const &argument,
+                                uint32_t const &   def) const
+{
+  return readValue<uint32_t>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+uint64_t SnapshotViewer::getu64(std::string const &argument,
+                                uint64_t const &   def) const
+{
+  return readValue<uint64_t>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+std::string SnapshotViewer::gets(std::string const &argument,
+                                 std::string const &def) const
+{
+  return readValue<std::string>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+std::vector<float> SnapshotViewer::getf32v(
+    std::string const &argument, std::vector<float> const &def) const
+{
+  return readValues<float>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+std::vector<double> SnapshotViewer::getf64v(
+    std::string const &argument, std::vector<double> const &def) const
+{
+  return readValues<double>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+std::vector<int32_t> SnapshotViewer::geti32v(
+    std::string const &argument, std::vector<int32_t> const &def) const
+{
+  return readValues<int32_t>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+std::vector<int64_t> SnapshotViewer::geti64v(
+    std::string const &argument, std::vector<int64_t> const &def) const
+{
+  return readValues<int64_t>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+std::vector<uint32_t> SnapshotViewer::getu32v(
+    std::string const &argument, std::vector<uint32_t> const &def) const
+{
+  return readValues<uint32_t>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+std::vector<uint64_t> SnapshotViewer::getu64v(
+    std::string const &argument, std::vector<uint64_t> const &def) const
+{
+  return readValues<uint64_t>(SnapshotSource{data}, begin, end, argument, def);
+}
+
+std::vector<std::string> SnapshotViewer::getsv(
+    std::string const &argument, std::vector<std::string> const &def) const
+{
+  return readStrings(SnapshotSource{data}, begin, end, argument, def);
+}
+
+/**
+ * @brief Returns viewer of context, it shares frozen memory with this viewer
+ *
+ * @param name name of context
+ *
+ * @return viewer of context, it is empty if context does not exist
+ */
+std::shared_ptr<SnapshotViewer> SnapshotViewer::getContext(
+    std::string const &name) const
+{
+  size_t rangeBegin = end, rangeEnd = end;
+  findContextRange(SnapshotSource{data}, begin, end, name, rangeBegin, rangeEnd);
+  return std::shared_ptr<SnapshotViewer>(
+      new SnapshotViewer(data, rangeBegin, rangeEnd));
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/argumentviewer_export.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Read-only viewer of frozen arguments.
+ * Frozen arguments are written by ArgumentViewer::writeSnapshot into memory
+ * that can be shared by several processes (see SharedSnapshot).
+ * Viewer only reads that memory, it does not copy arguments, so memory of
+ * processes that attach it does not grow with the size of arguments.
+ * auto snapshot = SharedSnapshot::publish(*args);
+ * //fork workers
+ * auto frozen = SnapshotViewer::attach(snapshot->getData(),snapshot->getSize());
+ * auto width  = frozen->getu32("--width",1024);
+ */
+class argumentViewer::SnapshotViewer {
+ public:
+  ARGUMENTVIEWER_EXPORT static std::shared_ptr<SnapshotViewer> attach(
+      void const* data,
+      size_t      size);
+  ARGUMENTVIEWER_EXPORT std::string getApplicationName() const;
+  ARGUMENTVIEWER_EXPORT size_t      getNofArguments() const;
+  ARGUMENTVIEWER_EXPORT std::string getArgument(size_t const& index) const;
+  ARGUMENTVIEWER_EXPORT bool        isPresent(std::string const& argument) const;
+  ARGUMENTVIEWER_EXPORT float       getf32(std::string const& argument,
+                                           float const&       def = 0.f) const;
+  ARGUMENTVIEWER_EXPORT double      getf64(std::string const& argument,
+                                           double const&      def = 0.) const;
+  ARGUMENTVIEWER_EXPORT int32_t     geti32(std::string const& argument,
+                                           int32_t const&     def = 0) const;
+  ARGUMENTVIEWER_EXPORT int64_t     geti64(std::string const& argument,
+                                           int64_t const&     def = 0) const;
+  ARGUMENTVIEWER_EXPORT uint32_t    getu32(std::string const& argument,
+                                           uint32_t const&    def = 0) const;
+  ARGUMENTVIEWER_EXPORT uint64_t    getu64(std::string const& argument,
+                                           uint64_t const&    def = 0) const;
+  ARGUMENTVIEWER_EXPORT std::string gets(std::string const& argument,
+                                         std::string const& def = "") const;
+  ARGUMENTVIEWER_EXPORT std::vector<float>    getf32v(std::string const&        argument,
+                                                      std::vector<float> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<double>   getf64v(std::string const&         argument,
+                                                      std::vector<double> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<int32_t>  geti32v(std::string const&          argument,
+                                                      std::vector<int32_t> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<int64_t>  geti64v(std::string const&          argument,
+                                                      std::vector<int64_t> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<uint32_t> getu32v(std::string const&           argument,
+                                                      std::vector<uint32_t> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<uint64_t> getu64v(std::string const&           argument,
+                                                      std::vector<uint64_t> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<std::string> getsv(std::string const&              argument,
+                                                       std::vector<std::string> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::shared_ptr<SnapshotViewer> getContext(
+      std::string const& name) const;
+
+ private:
+  SnapshotViewer(char const* data, size_t begin, size_t end);
+  char const* data;
+  size_t      begin;
+  size_t      end;
+};
@@ -0,0 +1,377 @@
+#include <ArgumentViewer/ArgumentViewer.h>
+#include <ArgumentViewer/Sweep.h>
+#include <ArgumentViewer/private/ArgumentReader.h>
+#include <ArgumentViewer/private/ArgumentViewerImpl.h>
+#include <ArgumentViewer/private/Globals.h>
+#include <ArgumentViewer/private/SweepData.h>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+using namespace argumentViewer;
+
+size_t const SweepData::noDimension;
+
+namespace {
+struct SweepSource {
+  SweepData const *   data;
+  SweepChoices const *choices;
+  Token const &       getToken(size_t index) const
+  {
+    auto const dimension = data->dimensions[index];
+    if (dimension == SweepData::noDimension) return data->arguments[index];
+    return choices->values[dimension];
+  }
+  Token::Kind getKind(size_t index) const { return getToken(index).kind; }
+  bool        isEqual(size_t index, string const &text) const
+  {
+    return getToken(index).text == text;
+  }
+  string getValue(size_t index) const { return getToken(index).getValue(); }
+  size_t getClosing(size_t index) const { return data->closing[index]; }
+};
+
+/**
+ * @brief Reads values of sweep block
+ *
+ * @return true if block contains at least one value and no delimiter
+ */
+bool readSweepValues(Tokens &      values,
+                     Tokens const &arguments,
+                     size_t        begin,
+                     size_t &      end)
+{
+  end = begin;
+  while (end < arguments.size() &&
+         (arguments[end].kind == Token::VALUE ||
+          arguments[end].kind == Token::ESCAPED_VALUE))
+    ++end;
+  if (end >= arguments.size() || end == begin) return false;
+  if (arguments[end].kind != Token::CONTEXT_END) return false;
+  values.assign(arguments.begin() + begin, arguments.begin() + end);
+  return true;
+}
+
+string rangeValueToString(double value, bool integral)
+{
+  if (integral) return val2canonical(static_cast<int64_t>(std::llround(value)));
+  return val2canonical(value);
+}
+
+// doubles are consecutive integers up to this value
+double const maxExactInteger = 9007199254740992.;
+
+/**
+ * @brief Reads range values first, last, step, values of range are not
+ * created
+ *
+ * @return false if range is not valid
+ */
+bool readRange(SweepDimension &range, Tokens const &values)
+{
+  if (values.size() < 2 || values.size() > 3) return false;
+  for (auto const &x : values)
+    if (!isValueConvertibleTo<double>(x.text)) return false;
+  for (auto const &x : values)
+    range.integral &= isValueConvertibleTo<int64_t>(x.text);
+  double const first = str2val<double>(values[0].text);
+  double const last  = str2val<double>(values[1].text);
+  double const step  = values.size() > 2 ? str2val<double>(values[2].text) : 1.;
+  if (!std::isfinite(first) || !std::isfinite(last) || !std::isfinite(step))
+    return false;
+  if (!(step > 0.) || last < first) return false;
+  double const length = std::floor((last - first) / step + 1e-9);
+  if (!(length < maxExactInteger)) return false;
+  // larger integers are written as floating point values
+  range.integral &= std::fabs(first) < maxExactInteger &&
+                    std::fabs(last) < maxExactInteger;
+  range.first     = first;
+  range.step      = step;
+  range.nofValues = static_cast<size_t>(length) + 1;
+  return true;
+}
+
+size_t getNofValues(SweepDimension const &sweep)
+{
+  if (sweep.values.empty()) return sweep.nofValues;
+  return sweep.values.size();
+}
+
+Token getValue(SweepDimension const &sweep,
+               size_t                choice,
+               Syntax const &        syntax)
+{
+  if (!sweep.values.empty()) return sweep.values[choice];
+  return Token(rangeValueToString(sweep.first + double(choice) * sweep.step,
+                                  sweep.integral),
+               syntax);
+}
+
+/**
+ * @brief Multiplies numbers of values of all sweeps
+ *
+ * @return number of configurations, 0 if it does not fit into size_t
+ */
+size_t computeNofConfigurations(vector<SweepDimension> const &sweeps)
+{
+  size_t result = 1;
+  for (auto const &x : sweeps) {
+    auto const nofValues = getNofValues(x);
+    if (nofValues != 0 && result > numeric_limits<size_t>::max() / nofValues)
+      return 0;
+    result *= nofValues;
+  }
+  return result;
+}
+
+void computeClosing(SweepData &data)
+{
+  data.closing.assign(data.arguments.size(), data.arguments.size());
+  vector<size_t> openContexts;
+  for (size_t i = 0; i < data.arguments.size(); ++i) {
+    auto const kind = data.arguments[i].kind;
+    if (kind == Token::CONTEXT_BEGIN) openContexts.push_back(i);
+    if (kind == Token::CONTEXT_END && !openContexts.empty()) {
+      data.closing[openContexts.back()] = i;
+      openContexts.pop_back();
+    }
+  }
+}
+
+/**
+ * @brief Replaces every sweep block by one argument of new dimension
+ */
+void parseSweeps(SweepData &data, Tokens const &arguments, Syntax const &syntax)
+{
+  size_t index = 0;
+  while (index < arguments.size()) {
+    auto const &text = arguments[index].text;
+    bool const isList  = text == sweepSymbol;
+    bool const isRange = text == rangeSymbol;
+    Tokens         values;
+    SweepDimension sweep;
+    size_t         end;
+    if ((isList || isRange) && index + 1 < arguments.size() &&
+        arguments[index + 1].kind == Token::CONTEXT_BEGIN &&
+        readSweepValues(values, arguments, index + 2, end) &&
+        (isList || readRange(sweep, values))) {
+      if (isList) sweep.values = values;
+      data.arguments.push_back(getValue(sweep, 0, syntax));
+      data.dimensions.push_back(data.sweeps.size());
+      data.sweeps.push_back(sweep);
+      index = end + 1;
+      continue;
+    }
+    data.arguments.push_back(arguments[index++]);
+    data.dimensions.push_back(SweepData::noDimension);
+  }
+  computeClosing(data);
+}
+}  // namespace
+
+/**
+ * @brief Creates sweep of arguments, all argument files are loaded
+ *
+ * @param base arguments with sweep and range blocks
+ */
+Sweep::Sweep(ArgumentViewer const &base)
+{
+  base.impl->resolveAllIncludes();
+  auto sweepData             = std::make_shared<SweepData>();
+  sweepData->applicationName = base.impl->applicationName;
+  sweepData->syntax          = base.impl->syntax;
+  parseSweeps(*sweepData, base.impl->arguments, base.impl->syntax);
+  sweepData->nofConfigurations = computeNofConfigurations(sweepData->sweeps);
+  if (sweepData->nofConfigurations == 0)
+    raiseError(*base.impl->error, Error::LIMIT_EXCEEDED,
+               "number of configurations of sweep does not fit into size_t");
+  data = sweepData;
+}
+
+size_t Sweep::getNofDimensions() const { return data->sweeps.size(); }
+
+size_t Sweep::getNofValues(size_t dimension) const
+{
+  return ::getNofValues(data->sweeps.at(dimension));
+}
+
+/**
+ * @brief Returns number of configurations
+ *
+ * @return product of numbers of values of all sweeps, 0 if it does not fit
+ * into size_t
+ */
+size_t Sweep::getNofConfigurations() const { return data->nofConfigurations; }
+
+/**
+ * @brief Returns configuration, the first dimension changes the fastest
+ *
+ * @param index index of configuration < getNofConfigurations()
+ *
+ * @return view of arguments with chosen values
+ */
+std::shared_ptr<SweepView> Sweep::getConfiguration(size_t index) const
+{
+  assert(index < getNofConfigurations());
+  auto choices = std::make_shared<SweepChoices>();
+  for (auto const &x : data->sweeps) {
+    auto const nofValues = ::getNofValues(x);
+    choices->choices.push_back(index % nofValues);
+    choices->values.push_back(
+        getValue(x, choices->choices.back(), data->syntax));
+    index /= nofValues;
+  }
+  return std::shared_ptr<SweepView>(
+      new SweepView(data, choices, 0, data->arguments.size()));
+}
+
+SweepView::SweepView(std::shared_ptr<SweepData const> const &   d,
+                     std::shared_ptr<SweepChoices const> const &c,
+                     size_t                                     b,
+                     size_t                                     e)
+    : data(d), choices(c), begin(b), end(e)
+{
+}
+
+std::string SweepView::getApplicationName() const
+{
+  return data->applicationName;
+}
+
+size_t SweepView::getNofArguments() const { return end - begin; }
+
+std::string SweepView::getArgument(size_t const &index) const
+{
+  assert(index < getNofArguments());
+  return SweepSource{data.get(), choices.get()}.getToken(begin + index).text;
+}
+
+/**
+ * @brief Returns index of chosen value of sweep
+ *
+ * @param dimension index of sweep
+ *
+ * @return index of value
+ */
+size_t SweepView::getChoice(size_t dimension) const
+{
+  return choices->choices.at(dimension);
+}
+
+bool SweepView::isPresent(std::string const &argument) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return findArgument(source, begin, end, argument) < end;
+}
+
+float SweepView::getf32(std::string const &argument, float const &def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValue<float>(source, begin, end, argument, def);
+}
+
+double SweepView::getf64(std::string const &argument, double const &def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValue<double>(source, begin, end, argument, def);
+}
+
+int32_t SweepView::geti32(std::string const &argument,
+                          int32_t const &    def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValue<int32_t>(source, begin, end, argument, def);
+}
+
+int64_t SweepView::geti64(std::string const &argument,
+                          int64_t const &    def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValue<int64_t>(source, begin, end, argument, def);
+}
+
+uint32_t SweepView::getu32(std::string const &argument,
+                           uint32_t const &   def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValue<uint32_t>(source, begin, end, argument, def);
+}
+
+uint64_t SweepView::getu64(std::string const &argument,
+                           uint64_t const &   def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValue<uint64_t>(source, begin, end, argument, def);
+}
+
+std::string SweepView::gets(std::string const &argument,
+                            std::string const &def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValue<std::string>(source, begin, end, argument, def);
+}
+
+std::vector<float> SweepView::getf32v(std::string const &       argument,
+                                      std::vector<float> const &def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValues<float>(source, begin, end, argument, def);
+}
+
+std::vector<double> SweepView::getf64v(std::string const &        argument,
+                                       std::vector<double> const &def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValues<double>(source, begin, end, argument, def);
+}
+
+std::vector<int32_t> SweepView::geti32v(std::string const &         argument,
+                                        std::vector<int32_t> const &def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValues<int32_t>(source, begin, end, argument, def);
+}
+
+std::vector<int64_t> SweepView::geti64v(std::string const &         argument,
+                                        std::vector<int64_t> const &def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValues<int64_t>(source, begin, end, argument, def);
+}
+
+std::vector<uint32_t> SweepView::getu32v(
+    std::string const &argument, std::vector<uint32_t> const &def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValues<uint32_t>(source, begin, end, argument, def);
+}
+
+std::vector<uint64_t> SweepView::getu64v(
+    std::string const &argument, std::vector<uint64_t> const &def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readValues<uint64_t>(source, begin, end, argument, def);
+}
+
+std::vector<std::string> SweepView::getsv(
+    std::string const &argument, std::vector<std::string> const &def) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  return readStrings(source, begin, end, argument, def);
+}
+
+/**
+ * @brief Returns view of context, it shares arguments and chosen values
+ *
+ * @param name name of context
+ *
+ * @return view of context, it is empty if context does not exist
+ */
+std::shared_ptr<SweepView> SweepView::getContext(std::string const &name) const
+{
+  SweepSource const source{data.get(), choices.get()};
+  size_t            rangeBegin = end, rangeEnd = end;
+  findContextRange(source, begin, end, name, rangeBegin, rangeEnd);
+  return std::shared_ptr<SweepView>(
+      new SweepView(data, choices, rangeBegin, rangeEnd));
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/argumentviewer_export.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Parameter sweep over arguments.
+ * Values of an argument can be swept by list or by range:
+ * --samples sweep { 1 2 4 8 } --resolution range { 512 1024 512 }
+ * Range contains first value, last value and optional step, its values are
+ * created only for requested configurations.
+ * Words sweep and range followed by context begin are keywords, escaped
+ * keywords (\sweep, \range) are ordinary values.
+ * Configurations are the Cartesian product of all sweeps, the first sweep
+ * changes the fastest. A configuration is created only when it is requested
+ * and it is only a view of shared arguments with chosen values.
+ * Sweep sf = Sweep(*args);
+ * for(size_t i=0;i<sf.getNofConfigurations();++i){
+ *   auto c = sf.getConfiguration(i);
+ *   auto samples = c->getu32("--samples");
+ * }
+ */
+class argumentViewer::Sweep {
+ public:
+  ARGUMENTVIEWER_EXPORT Sweep(ArgumentViewer const& base);
+  ARGUMENTVIEWER_EXPORT size_t getNofDimensions() const;
+  ARGUMENTVIEWER_EXPORT size_t getNofValues(size_t dimension) const;
+  ARGUMENTVIEWER_EXPORT size_t getNofConfigurations() const;
+  ARGUMENTVIEWER_EXPORT std::shared_ptr<SweepView> getConfiguration(
+      size_t index) const;
+
+ private:
+  std::shared_ptr<SweepData const> data;
+};
+
+/**
+ * @brief Read-only view of one configuration of Sweep
+ */
+class argumentViewer::SweepView {
+ public:
+  ARGUMENTVIEWER_EXPORT std::string getApplicationName() const;
+  ARGUMENTVIEWER_EXPORT size_t      getNofArguments() const;
+  ARGUMENTVIEWER_EXPORT std::string getArgument(size_t const& index) const;
+  ARGUMENTVIEWER_EXPORT size_t      getChoice(size_t dimension) const;
+  ARGUMENTVIEWER_EXPORT bool        isPresent(std::string const& argument) const;
+  ARGUMENTVIEWER_EXPORT float       getf32(std::string const& argument,
+                                           float const&       def = 0.f) const;
+  ARGUMENTVIEWER_EXPORT double      getf64(std::string const& argument,
+                                           double const&      def = 0.) const;
+  ARGUMENTVIEWER_EXPORT int32_t     geti32(std::string const& argument,
+                                           int32_t const&     def = 0) const;
+  ARGUMENTVIEWER_EXPORT int64_t     geti64(std::string const& argument,
+                                           int64_t const&     def = 0) const;
+  ARGUMENTVIEWER_EXPORT uint32_t    getu32(std::string const& argument,
+                                           uint32_t const&    def = 0) const;
+  ARGUMENTVIEWER_EXPORT uint64_t    getu64(std::string const& argument,
+                                           uint64_t const&    def = 0) const;
+  ARGUMENTVIEWER_EXPORT std::string gets(std::string const& argument,
+                                         std::string const& def = "") const;
+  ARGUMENTVIEWER_EXPORT std::vector<float>    getf32v(std::string const&        argument,
+                                                      std::vector<float> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<double>   getf64v(std::string const&         argument,
+                                                      std::vector<double> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<int32_t>  geti32v(std::string const&          argument,
+                                                      std::vector<int32_t> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<int64_t>  geti64v(std::string const&          argument,
+                                                      std::vector<int64_t> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<uint32_t> getu32v(std::string const&           argument,
+                                                      std::vector<uint32_t> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<uint64_t> getu64v(std::string const&           argument,
+                                                      std::vector<uint64_t> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::vector<std::string> getsv(std::string const&              argument,
+                                                       std::vector<std::string> const& def = {}) const;
+  ARGUMENTVIEWER_EXPORT std::shared_ptr<SweepView> getContext(
+      std::string const& name) const;
+
+ private:
+  friend class Sweep;
+  SweepView(std::shared_ptr<SweepData const> const&    data,
+            std::shared_ptr<SweepChoices const> const& choices,
+            size_t                                     begin,
+            size_t                                     end);
+  std::shared_ptr<SweepData const>    data;
+  std::shared_ptr<SweepChoices const> choices;
+  size_t                              begin;
+  size_t                              end;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+
+/**
+ * @brief Delimiters of arguments.
+ * Every delimiter is one character. Escaped delimiter (for example "\{")
+ * is read as ordinary value, so are escaped keywords "\sweep" and "\range"
+ * of Sweep.
+ */
+struct argumentViewer::Syntax {
+  char contextBegin = '{';
+  char contextEnd   = '}';
+  char fileSymbol   = '<';
+};
+
+namespace argumentViewer {
+/**
+ * @brief Syntax policy of BasicArgumentViewer, it is used by ArgumentViewer
+ * struct ShellSyntax{
+ *   static char const contextBegin = '[';
+ *   static char const contextEnd   = ']';
+ *   static char const fileSymbol   = '@';
+ * };
+ */
+struct DefaultSyntax {
+  static char const contextBegin = '{';
+  static char const contextEnd   = '}';
+  static char const fileSymbol   = '<';
+};
+
+template <typename SYNTAX>
+Syntax toSyntax()
+{
+  Syntax result;
+  result.contextBegin = SYNTAX::contextBegin;
+  result.contextEnd   = SYNTAX::contextEnd;
+  result.fileSymbol   = SYNTAX::fileSymbol;
+  return result;
+}
+}  // namespace argumentViewer
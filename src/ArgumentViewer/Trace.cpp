@@ -0,0 +1,35 @@
+#include <ArgumentViewer/Trace.h>
+#include <ArgumentViewer/private/TraceImpl.h>
+
+using namespace argumentViewer;
+
+/**
+ * @brief Creates empty trace
+ *
+ * @param capacity maximal number of recorded spans
+ */
+Trace::Trace(size_t capacity) : impl(std::make_shared<TraceImpl>(capacity)) {}
+
+Trace::~Trace() {}
+
+/**
+ * @brief Returns number of spans in ring buffer
+ *
+ * @return number of spans, it is not greater than capacity
+ */
+size_t Trace::getNofSpans() const { return impl->getNofSpans(); }
+
+/**
+ * @brief Writes recorded spans in Chrome trace event JSON format
+ *
+ * @param stream output stream
+ */
+void Trace::writeChromeTrace(std::ostream &stream) const
+{
+  impl->writeChromeTrace(stream);
+}
+
+/**
+ * @brief Removes all recorded spans
+ */
+void Trace::clear() { impl->clear(); }
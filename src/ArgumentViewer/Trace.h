@@ -0,0 +1,33 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/argumentviewer_export.h>
+#include <iosfwd>
+#include <memory>
+
+/**
+ * @brief Timeline of ArgumentViewer work.
+ * Spans of construction, loading and tokenization of argument files,
+ * validate(), toStr() and reads of arguments are recorded into ring buffer,
+ * the oldest spans are overwritten when it is full.
+ * auto settings  = argumentViewer::Settings();
+ * settings.trace = std::make_shared<argumentViewer::Trace>();
+ * auto args = std::make_shared<ArgumentViewer>(argc,argv,settings);
+ * ...
+ * std::ofstream file("trace.json");
+ * settings.trace->writeChromeTrace(file);
+ * Written file can be opened by chrome://tracing or Perfetto.
+ * Without trace, recording costs one branch per span.
+ */
+class argumentViewer::Trace {
+ public:
+  ARGUMENTVIEWER_EXPORT Trace(size_t capacity = 4096);
+  ARGUMENTVIEWER_EXPORT ~Trace();
+  ARGUMENTVIEWER_EXPORT size_t getNofSpans() const;
+  ARGUMENTVIEWER_EXPORT void   writeChromeTrace(std::ostream& stream) const;
+  ARGUMENTVIEWER_EXPORT void   clear();
+
+ private:
+  friend class ArgumentViewer;
+  std::shared_ptr<TraceImpl> impl;
+};
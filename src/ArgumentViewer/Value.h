@@ -0,0 +1,75 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Customization point for user value types.
+ * Specialize it in namespace argumentViewer and use the type with
+ * ArgumentViewer::get<TYPE> and ArgumentViewer::getv<TYPE>:
+ * template<>struct argumentViewer::ValueTraits<Resolution>{
+ *   static std::string typeName(){return "resolution";}
+ *   static bool parse(std::string const&text,Resolution&value);
+ *   static std::string toString(Resolution const&value);
+ * };
+ * TYPE has to have operator== for comparison of default values.
+ * Values are identified by TypedValue<TYPE>::id, if a shared library
+ * has its own copy of the id, its values are incompatible definitions.
+ */
+namespace argumentViewer {
+template <typename TYPE>
+struct ValueTraits;
+}
+
+/**
+ * @brief Value of user type without its type.
+ * It is used for passing user values and their parser through ArgumentViewer.
+ */
+class argumentViewer::Value {
+ public:
+  virtual ~Value() {}
+  virtual void const*            getTypeId() const                     = 0;
+  virtual std::string            getType() const                       = 0;
+  virtual std::string            toStr() const                         = 0;
+  virtual std::shared_ptr<Value> parse(std::string const& text) const = 0;
+  virtual std::shared_ptr<Value> clone() const                         = 0;
+  virtual bool                   isEqual(Value const& other) const     = 0;
+};
+
+namespace argumentViewer {
+template <typename TYPE>
+class TypedValue : public Value {
+ public:
+  TypedValue(TYPE const& v = TYPE()) : value(v) {}
+  virtual void const* getTypeId() const override { return &id; }
+  virtual std::string getType() const override
+  {
+    return ValueTraits<TYPE>::typeName();
+  }
+  virtual std::string toStr() const override
+  {
+    return ValueTraits<TYPE>::toString(value);
+  }
+  virtual std::shared_ptr<Value> parse(std::string const& text) const override
+  {
+    auto result = std::make_shared<TypedValue<TYPE>>();
+    if (!ValueTraits<TYPE>::parse(text, result->value)) return nullptr;
+    return result;
+  }
+  virtual std::shared_ptr<Value> clone() const override
+  {
+    return std::make_shared<TypedValue<TYPE>>(value);
+  }
+  virtual bool isEqual(Value const& other) const override
+  {
+    return other.getTypeId() == getTypeId() &&
+           static_cast<TypedValue<TYPE> const&>(other).value == value;
+  }
+  TYPE value;
+  static char const id;
+};
+
+template <typename TYPE>
+char const TypedValue<TYPE>::id = 0;
+}  // namespace argumentViewer
@@ -0,0 +1,244 @@
+#include <ArgumentViewer/private/ArgumentFileCache.h>
+#include <ArgumentViewer/private/Hash128.h>
+#include <ArgumentViewer/private/JsonReader.h>
+
+#include <MealyMachine/MealyMachine.h>
+#include <algorithm>
+#include <fstream>
+#include <sys/stat.h>
+
+size_t const ArgumentFileCache::unlimited;
+
+namespace {
+/**
+ * @brief Reads file by blocks and stops one byte after maxBytes,
+ * size reported by file system is not used, files in /proc or pipes report 0
+ */
+string readFile(string const &fileName, size_t maxBytes)
+{
+  ifstream     file(fileName, ios::binary);
+  string       content;
+  char         buffer[4096];
+  size_t const budget =
+      maxBytes == ArgumentFileCache::unlimited ? maxBytes : maxBytes + 1;
+  while (file && content.size() < budget) {
+    file.read(buffer, min<size_t>(sizeof(buffer), budget - content.size()));
+    content.append(buffer, static_cast<size_t>(file.gcount()));
+  }
+  return content;
+}
+}  // namespace
+
+ArgumentFileCache::ArgumentFileCache(
+    argumentViewer::Syntax const &s, shared_ptr<argumentViewer::TraceImpl> const &t)
+    : syntax(s), trace(t)
+{
+}
+
+bool ArgumentFileCache::FileStamp::operator==(FileStamp const &other) const
+{
+  return exists == other.exists &&
+         modificationTime == other.modificationTime &&
+         modificationNanoseconds == other.modificationNanoseconds &&
+         size == other.size;
+}
+
+ArgumentFileCache::FileStamp ArgumentFileCache::getFileStamp(
+    string const &fileName)
+{
+  FileStamp   stamp;
+  struct stat info;
+  if (stat(fileName.c_str(), &info) != 0) return stamp;
+  stamp.exists           = true;
+  stamp.modificationTime = info.st_mtime;
+#if defined(__APPLE__)
+  stamp.modificationNanoseconds = info.st_mtimespec.tv_nsec;
+#elif !defined(_WIN32)
+  stamp.modificationNanoseconds = info.st_mtim.tv_nsec;
+#endif
+  stamp.size             = info.st_size;
+  return stamp;
+}
+
+/**
+ * @brief Reads file, content that is the same as content of old version is
+ * not tokenized again
+ *
+ * @param fileName name of argument file
+ * @param maxBytes maximal number of bytes that are read
+ * @param old version of file read before, it can be nullptr
+ *
+ * @return file or nullptr if file does not exist
+ */
+shared_ptr<ArgumentFileCache::ArgumentFile const> ArgumentFileCache::loadFile(
+    string const &fileName, size_t maxBytes, ArgumentFile const *old) const
+{
+  auto file   = make_shared<ArgumentFile>();
+  file->stamp = getFileStamp(fileName);
+  if (!file->stamp.exists) return nullptr;
+  auto const content = readFile(fileName, maxBytes);
+  hash128(content.data(), content.size(), file->hashLow, file->hashHigh);
+  // time stamps are updated by a coarse clock, the file can be modified
+  // again without change of its stamp
+  file->racy         = time(nullptr) <= file->stamp.modificationTime + 1;
+  file->nofReadBytes = content.size();
+  file->complete     = content.size() <= maxBytes;
+  if (old && old->complete && file->complete && old->hashLow == file->hashLow &&
+      old->hashHigh == file->hashHigh) {
+    file->arguments = old->arguments;
+    file->source    = old->source;
+    file->error     = old->error;
+    return file;
+  }
+  auto arguments  = make_shared<Tokens>();
+  file->arguments = arguments;
+  file->source    = make_shared<TokenSource>();
+  if (!file->complete) return file;
+  TraceSpan  span(trace.get(), "tokenize", fileName);
+  file->source->name = fileName;
+  if (!isJsonFile(fileName))
+    splitFileToArguments(*arguments, content, syntax,
+                         &file->source->positions);
+  else if (!splitJsonToArguments(*arguments, content, syntax,
+                                 &file->source->positions, file->error))
+    file->source = make_shared<TokenSource>();
+  return file;
+}
+
+/**
+ * @brief Returns tokenized content of file, file is read only once
+ * File longer than maxBytes is read only up to one byte over the limit and it
+ * has no arguments, getNofReadBytes() reports it.
+ *
+ * @param fileName name of argument file
+ * @param maxBytes maximal number of bytes that are read
+ *
+ * @return arguments of file or nullptr if file does not exist
+ */
+Tokens const *ArgumentFileCache::getArguments(string const &fileName,
+                                              size_t        maxBytes)
+{
+  auto it = files.find(fileName);
+  if (it == files.end() ||
+      (!it->second->complete && it->second->nofReadBytes <= maxBytes)) {
+    TraceSpan span(trace.get(), "load file", fileName);
+    auto file = loadFile(fileName, maxBytes);
+    if (!file) return nullptr;
+    if (it == files.end())
+      it = files.emplace(fileName, file).first;
+    else
+      it->second = file;
+  }
+  return it->second->arguments.get();
+}
+
+shared_ptr<TokenSource const> ArgumentFileCache::getSource(
+    string const &fileName) const
+{
+  auto const it = files.find(fileName);
+  if (it == files.end()) return nullptr;
+  return it->second->source;
+}
+
+string ArgumentFileCache::getError(string const &fileName) const
+{
+  auto const it = files.find(fileName);
+  if (it == files.end()) return "";
+  return it->second->error;
+}
+
+size_t ArgumentFileCache::getNofReadBytes(string const &fileName) const
+{
+  auto const it = files.find(fileName);
+  if (it == files.end()) return 0;
+  return it->second->nofReadBytes;
+}
+
+/**
+ * @brief Reads again files that were modified since they were read,
+ * files that do not exist anymore are removed
+ *
+ * @param maxBytes maximal number of bytes that are read from one file
+ *
+ * @return true if at least one file was modified or removed
+ */
+bool ArgumentFileCache::update(size_t maxBytes)
+{
+  bool changed = false;
+  auto it      = files.begin();
+  while (it != files.end()) {
+    auto const &old = *it->second;
+    if (getFileStamp(it->first) == old.stamp && !old.racy && old.complete) {
+      ++it;
+      continue;
+    }
+    auto file = loadFile(it->first, maxBytes, &old);
+    if (!file) {
+      changed = true;
+      it      = files.erase(it);
+      continue;
+    }
+    // file with the same content keeps its arguments, it is not a change
+    bool const sameContent = file->arguments == old.arguments;
+    changed    = changed || !sameContent;
+    it->second = file;
+    ++it;
+  }
+  return changed;
+}
+
+void splitFileToArguments(Tokens &                       tokens,
+                          string const &                 fileContent,
+                          argumentViewer::Syntax const &syntax,
+                          PositionList *                 positions)
+{
+  vector<string>             args;
+  // lines are counted incrementally, words are found in increasing order
+  size_t                     scanned   = 0;
+  size_t                     line      = 1;
+  size_t                     lineStart = 0;
+  auto                       addPosition = [&](char const *symbol) {
+    auto const offset = static_cast<size_t>(symbol - fileContent.c_str());
+    for (; scanned < offset; ++scanned)
+      if (fileContent[scanned] == '\n') {
+        ++line;
+        lineStart = scanned + 1;
+      }
+    positions->add(line, offset - lineStart + 1);
+  };
+  mealyMachine::MealyMachine mm;
+  auto                       start        = mm.addState();
+  auto                       space        = mm.addState();
+  auto                       word         = mm.addState();
+  auto                       comment      = mm.addState();
+  auto                       startNewWord = [&](mealyMachine::MealyMachine *) {
+    args.push_back("");
+    args.back() += *(char *)mm.getCurrentSymbol();
+    if (positions) addPosition((char const *)mm.getCurrentSymbol());
+  };
+  auto addCharToWord = [&](mealyMachine::MealyMachine *) {
+    args.back() += *(char *)mm.getCurrentSymbol();
+  };
+  mm.addTransition(start, " \t\n\r", space);
+  mm.addTransition(start, "#", comment);
+  mm.addElseTransition(start, word, startNewWord);
+  mm.addEOFTransition(start);
+
+  mm.addTransition(space, " \t\n\r", space);
+  mm.addTransition(space, "#", comment);
+  mm.addElseTransition(space, word, startNewWord);
+  mm.addEOFTransition(space);
+
+  mm.addTransition(comment, "\n\r", start);
+  mm.addElseTransition(comment, comment);
+  mm.addEOFTransition(comment);
+
+  mm.addTransition(word, " \t\n\r", space);
+  mm.addTransition(word, "#", comment);
+  mm.addElseTransition(word, word, addCharToWord);
+  mm.addEOFTransition(word);
+
+  mm.match(fileContent.c_str());
+  tokens.reserve(tokens.size() + args.size());
+  for (auto &x : args) tokens.emplace_back(std::move(x), syntax);
+}
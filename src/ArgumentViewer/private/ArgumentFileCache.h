@@ -0,0 +1,74 @@
+#pragma once
+
+#include <ArgumentViewer/private/Provenance.h>
+#include <ArgumentViewer/private/Token.h>
+#include <ArgumentViewer/private/TraceImpl.h>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Tokenized content of argument files together with their
+ * modification stamps.
+ * Copies share unchanged files, so a reload can be prepared in a copy
+ * while the old cache is still in use.
+ */
+class ArgumentFileCache {
+ public:
+  ArgumentFileCache(argumentViewer::Syntax const &               syntax = {},
+                    shared_ptr<argumentViewer::TraceImpl> const &trace  = nullptr);
+  Tokens const *getArguments(string const &fileName,
+                             size_t        maxBytes = unlimited);
+  // source of loaded file, nullptr if the file is not loaded
+  shared_ptr<TokenSource const> getSource(string const &fileName) const;
+  // syntax error of loaded JSON file, empty if there is no error
+  string                getError(string const &fileName) const;
+  bool                  update(size_t maxBytes = unlimited);
+  // number of bytes read from loaded file, it is over the limit of reading
+  // if the file was not read completely
+  size_t                getNofReadBytes(string const &fileName) const;
+  static size_t const   unlimited = std::numeric_limits<size_t>::max();
+
+ protected:
+  struct FileStamp {
+    bool   exists           = false;
+    time_t modificationTime = 0;
+    long   modificationNanoseconds = 0;
+    long long size          = 0;
+    bool   operator==(FileStamp const &other) const;
+  };
+  struct ArgumentFile {
+    FileStamp      stamp;
+    // arguments are shared by versions of file with the same content
+    shared_ptr<Tokens const> arguments;
+    shared_ptr<TokenSource>  source;
+    string         error;
+    size_t         nofReadBytes = 0;
+    // file was longer than the limit, it is not tokenized
+    bool           complete     = true;
+    uint64_t       hashLow  = 0;
+    uint64_t       hashHigh = 0;
+    // file was modified within resolution of its time stamp when it was read,
+    // a change with the same stamp is found by content
+    bool           racy     = false;
+  };
+  static FileStamp                      getFileStamp(string const &fileName);
+  shared_ptr<ArgumentFile const> loadFile(
+      string const &      fileName,
+      size_t              maxBytes,
+      ArgumentFile const *old = nullptr) const;
+  argumentViewer::Syntax                      syntax;
+  shared_ptr<argumentViewer::TraceImpl>       trace;
+  map<string, shared_ptr<ArgumentFile const>> files;
+};
+
+void splitFileToArguments(Tokens &                       args,
+                          string const &                 fileContent,
+                          argumentViewer::Syntax const &syntax,
+                          PositionList *                 positions = nullptr);
@@ -1,14 +1,34 @@
-#include <ArgumentViewer/Exception.h>
 #include <ArgumentViewer/private/ArgumentListFormat.h>
 #include <ArgumentViewer/private/CommonFunctions.h>
 #include <ArgumentViewer/private/ContextFormat.h>
+#include <ArgumentViewer/private/IncrementalMatcher.h>
 #include <set>
 #include <algorithm>
 
-using namespace argumentViewer::ex;
+using namespace argumentViewer;
 
 ArgumentListFormat::ArgumentListFormat(string const &com) : Format(com) {}
 
+/**
+ * @brief Releases formats of nested contexts one by one,
+ * deep hierarchy does not overflow the call stack
+ */
+ArgumentListFormat::~ArgumentListFormat()
+{
+  vector<shared_ptr<Format>> released;
+  auto const release = [&](ArgumentListFormat &list) {
+    for (auto &x : list.formats)
+      if (x.second.use_count() == 1 && isTypeOf<ArgumentListFormat>(x.second))
+        released.push_back(std::move(x.second));
+  };
+  release(*this);
+  while (!released.empty()) {
+    auto const format = std::move(released.back());
+    released.pop_back();
+    release(static_cast<ArgumentListFormat &>(*format));
+  }
+}
+
 bool isContextFormat(shared_ptr<Format> const &x)
 {
   return isTypeOf<ContextFormat>(x);
@@ -19,7 +39,7 @@ void updateLengthsIfFoundLarger(size_t &                  nameLength,
                                 size_t &                  typeLength,
                                 shared_ptr<Format> const &format)
 {
-  auto vf = dynamic_pointer_cast<ValueFormat>(format);
+  auto vf = formatCast<ValueFormat>(format);
   if (!vf) return;
   nameLength     = max(nameLength, vf->getName().length());
   defaultsLength = max(defaultsLength, vf->getDefaultsLength());
@@ -60,99 +80,88 @@ void ArgumentListFormat::writeIndentedNonContextFormats(stringstream &ss,
                           indent);
 }
 
-void writeContextFormat(stringstream &            ss,
-                        shared_ptr<Format> const &format,
-                        size_t                    indent)
-{
-  if (!isContextFormat(format)) return;
-  ss << format->toStr(indent);
-}
-
-void ArgumentListFormat::writeContextFormats(stringstream &ss,
-                                             size_t        indent) const
+void ArgumentListFormat::writeNonContextFormats(stringstream &ss,
+                                                size_t        indent) const
 {
-  for (auto const &x : formats) writeContextFormat(ss, x.second, indent);
-}
-
-string ArgumentListFormat::toStr(size_t indent, size_t, size_t, size_t) const
-{
-  stringstream ss;
-  size_t       nameLength     = 0;
-  size_t       defaultsLength = 0;
-  size_t       typeLength     = 0;
+  size_t nameLength     = 0;
+  size_t defaultsLength = 0;
+  size_t typeLength     = 0;
   getLargestLengths(nameLength, defaultsLength, typeLength);
   writeIndentedNonContextFormats(ss, nameLength, defaultsLength, typeLength,
                                  indent);
-  writeContextFormats(ss, indent);
-  return ss.str();
 }
 
-void throwIfUnusedFormatsIsEmpty(set<string> const &   unusedFormats,
-                                 vector<string> const &args,
-                                 size_t &              index)
+/**
+ * @brief Writes formats of list and all its nested contexts into one stream.
+ * Contexts are visited using explicit stack, so the cost does not depend on
+ * depth of contexts and deep contexts cannot overflow call stack.
+ *
+ * @param ss output
+ * @param indent indentation of formats of this list
+ */
+void ArgumentListFormat::writeHierarchy(stringstream &ss, size_t indent) const
 {
-  if (!unusedFormats.empty()) return;
-  stringstream ss;
-  ss << "Argument error:" << endl;
-  ss << "following arguments cannot be matched: " << endl;
-  for (size_t i = index; i < args.size(); ++i) ss << args.at(i) << " ";
-  throw MatchError(ss.str());
+  struct Level {
+    ArgumentListFormat const *                      list;
+    map<string, shared_ptr<Format>>::const_iterator next;
+    // nullptr for this list, its end is written by caller
+    ContextFormat const *                           context;
+    size_t                                          indent;
+  };
+  vector<Level> stack;
+  writeNonContextFormats(ss, indent);
+  stack.push_back({this, formats.begin(), nullptr, indent});
+  while (!stack.empty()) {
+    auto &level = stack.back();
+    while (level.next != level.list->formats.end() &&
+           !isContextFormat(level.next->second))
+      ++level.next;
+    if (level.next == level.list->formats.end()) {
+      if (level.context) level.context->writeEnd(ss, level.indent - 2);
+      stack.pop_back();
+      continue;
+    }
+    auto const context =
+        static_pointer_cast<ContextFormat>((level.next++)->second);
+    auto const contextIndent = level.indent + 2;
+    context->writeBegin(ss, level.indent);
+    context->writeNonContextFormats(ss, contextIndent);
+    stack.push_back(
+        {context.get(), context->formats.begin(), context.get(), contextIndent});
+  }
 }
 
-void throwIfFormatForRemovalIsEmpty(string const &        formatForRemoval,
-                                    vector<string> const &args,
-                                    size_t &              index)
+string ArgumentListFormat::toStr(size_t indent, size_t, size_t, size_t) const
 {
-  if (formatForRemoval != "") return;
   stringstream ss;
-  ss << "Argument error:" << endl;
-  ss << "argument: " << args.at(index) << " at index: " << index
-     << " cannot be matched";
-  throw MatchError(ss.str());
+  writeHierarchy(ss, indent);
+  return ss.str();
 }
 
-string ArgumentListFormat::matchOneUnusedFormat(
-    set<string> const &   unusedFormats,
-    vector<string> const &args,
-    size_t &              index) const
+void skipUnknownArgument(Tokens const &        args, size_t &index)
 {
-  for (auto const &f : unusedFormats) {
-    auto const status = formats.at(f)->match(args, index);
-    if (status == MATCH_SUCCESS) return f;
+  ++index;
+  if (isContextBeginMissing(args, index)) return;
+  ++index;
+  size_t contextCounter = 0;
+  while (index < args.size()) {
+    auto const kind = args.at(index++).kind;
+    if (kind == Token::CONTEXT_BEGIN) ++contextCounter;
+    if (kind != Token::CONTEXT_END) continue;
+    if (contextCounter == 0) return;
+    --contextCounter;
   }
-  return "";
-}
-
-set<string> ArgumentListFormat::getUnusedFormats() const
-{
-  set<string> unusedFormats;
-  for (auto const &x : formats) unusedFormats.insert(x.first);
-  return unusedFormats;
-}
-
-void ArgumentListFormat::checkAndMatchOneUnusedFormat(
-    set<string> &         unusedFormats,
-    vector<string> const &args,
-    size_t &              index) const
-{
-  throwIfUnusedFormatsIsEmpty(unusedFormats, args, index);
-  string formatForRemoval = matchOneUnusedFormat(unusedFormats, args, index);
-  throwIfFormatForRemovalIsEmpty(formatForRemoval, args, index);
-  unusedFormats.erase(formatForRemoval);
 }
 
-void ArgumentListFormat::matchUnusedFormats(set<string> &         unusedFormats,
-                                            vector<string> const &args,
-                                            size_t &              index) const
+Format::MatchStatus ArgumentListFormat::match(Tokens const &        args,
+                                              size_t &              index,
+                                              Diagnostics &diagnostics) const
 {
-  while (index < args.size())
-    checkAndMatchOneUnusedFormat(unusedFormats, args, index);
+  IncrementalMatcher::matchOnce(*this, args, index, diagnostics);
+  return MATCH_SUCCESS;
 }
 
-Format::MatchStatus ArgumentListFormat::match(vector<string> const &args,
-                                              size_t &              index) const
+bool ArgumentListFormat::isOfType(FormatTypeId id) const
 {
-  auto unusedFormats = getUnusedFormats();
-  matchUnusedFormats(unusedFormats, args, index);
-  return MATCH_SUCCESS;
+  return id == getFormatTypeId<ArgumentListFormat>() || Format::isOfType(id);
 }
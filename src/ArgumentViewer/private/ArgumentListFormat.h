@@ -9,12 +9,15 @@ class ContextFormat;
 class ArgumentListFormat : public Format {
  public:
   ArgumentListFormat(string const &com);
+  ~ArgumentListFormat();
   virtual string                  toStr(size_t indent,
                                         size_t = 0,
                                         size_t = 0,
                                         size_t = 0) const override;
-  virtual MatchStatus             match(vector<string> const &args,
-                                        size_t &              index) const override;
+  virtual MatchStatus             match(Tokens const &        args,
+                                        size_t &              index,
+                                        Diagnostics &diagnostics) const override;
+  virtual bool                    isOfType(FormatTypeId id) const override;
   map<string, shared_ptr<Format>> formats;
 
  protected:
@@ -26,15 +29,8 @@ class ArgumentListFormat : public Format {
                                              size_t        defaultsLength,
                                              size_t        typeLength,
                                              size_t        indent) const;
-  void        writeContextFormats(stringstream &ss, size_t indent) const;
-  string      matchOneUnusedFormat(set<string> const &   unusedFormats,
-                                   vector<string> const &args,
-                                   size_t &              index) const;
-  void        checkAndMatchOneUnusedFormat(set<string> &         unusedFormats,
-                                           vector<string> const &args,
-                                           size_t &              index) const;
-  void        matchUnusedFormats(set<string> &         unusedFormats,
-                                 vector<string> const &args,
-                                 size_t &              index) const;
-  set<string> getUnusedFormats() const;
+  void        writeNonContextFormats(stringstream &ss, size_t indent) const;
+  void        writeHierarchy(stringstream &ss, size_t indent) const;
 };
+
+void skipUnknownArgument(Tokens const &args, size_t &index);
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <ArgumentViewer/private/CommonFunctions.h>
+#include <ArgumentViewer/private/Token.h>
+
+/**
+ * @brief Read-only lookups of read-only viewers (SnapshotViewer, SweepView).
+ * SOURCE has to provide:
+ * Token::Kind getKind(size_t index) const;
+ * bool isEqual(size_t index, string const&text) const;
+ * string getValue(size_t index) const;
+ * size_t getClosing(size_t index) const; // matching context end of context begin
+ * Contexts are skipped by their matching context end, so lookups do not
+ * visit arguments of contexts.
+ */
+template <typename SOURCE>
+size_t findArgument(SOURCE const &source,
+                    size_t        begin,
+                    size_t        end,
+                    string const &argument)
+{
+  size_t argumentIndex = begin;
+  while (argumentIndex < end) {
+    if (source.isEqual(argumentIndex, argument)) return argumentIndex;
+    auto const kind = source.getKind(argumentIndex);
+    if (kind == Token::CONTEXT_END) return end;
+    if (kind == Token::CONTEXT_BEGIN) argumentIndex = source.getClosing(argumentIndex);
+    ++argumentIndex;
+  }
+  return end;
+}
+
+template <typename SOURCE>
+bool findContextRange(SOURCE const &source,
+                      size_t        begin,
+                      size_t        end,
+                      string const &argument,
+                      size_t &      rangeBegin,
+                      size_t &      rangeEnd)
+{
+  size_t const argumentIndex = findArgument(source, begin, end, argument) + 1;
+  if (argumentIndex >= end) return false;
+  if (source.getKind(argumentIndex) != Token::CONTEXT_BEGIN) return false;
+  size_t const closing = source.getClosing(argumentIndex);
+  if (closing >= end) return false;
+  rangeBegin = argumentIndex + 1;
+  rangeEnd   = closing;
+  return true;
+}
+
+template <typename TYPE, typename SOURCE>
+TYPE readValue(SOURCE const &source,
+               size_t        begin,
+               size_t        end,
+               string const &argument,
+               TYPE const &  def)
+{
+  size_t const i = findArgument(source, begin, end, argument) + 1;
+  if (i >= end) return def;
+  auto const value = source.getValue(i);
+  if (!isValueConvertibleTo<TYPE>(value)) return def;
+  return str2val<TYPE>(value);
+}
+
+template <typename TYPE, typename SOURCE>
+vector<TYPE> readValues(SOURCE const &      source,
+                        size_t              begin,
+                        size_t              end,
+                        string const &      argument,
+                        vector<TYPE> const &def)
+{
+  size_t argumentIndex = findArgument(source, begin, end, argument);
+  if (argumentIndex >= end) return def;
+  ++argumentIndex;
+  vector<TYPE> result;
+  while (argumentIndex < end) {
+    auto const value = source.getValue(argumentIndex++);
+    if (!isValueConvertibleTo<TYPE>(value)) break;
+    result.push_back(str2val<TYPE>(value));
+  }
+  while (result.size() < def.size()) result.push_back(def.at(result.size()));
+  return result;
+}
+
+template <typename SOURCE>
+vector<string> readStrings(SOURCE const &        source,
+                           size_t                begin,
+                           size_t                end,
+                           string const &        argument,
+                           vector<string> const &def)
+{
+  size_t rangeBegin = 0, rangeEnd = 0;
+  if (!findContextRange(source, begin, end, argument, rangeBegin, rangeEnd))
+    return def;
+  vector<string> result;
+  for (size_t i = rangeBegin; i < rangeEnd; ++i)
+    result.push_back(source.getValue(i));
+  while (def.size() > result.size()) result.push_back(def[result.size()]);
+  return result;
+}
@@ -1,23 +1,160 @@
 #include <ArgumentViewer/Exception.h>
 #include <ArgumentViewer/private/ArgumentViewerImpl.h>
-#include <ArgumentViewer/private/Globals.h>
+#include <ArgumentViewer/private/ChangedArguments.h>
+#include <ArgumentViewer/private/EffectiveConfiguration.h>
+#include <ArgumentViewer/private/Snapshot.h>
 #include <ArgumentViewer/private/IsPresentFormat.h>
 #include <ArgumentViewer/private/ContextFormat.h>
+#include <ArgumentViewer/private/ForwardedContextFormat.h>
 #include <ArgumentViewer/private/StringVectorFormat.h>
 
-#include <MealyMachine/MealyMachine.h>
 #include <ArgumentViewer/ArgumentViewer.h>
 
 using namespace argumentViewer;
 
+/**
+ * @brief Throws error or it stores the first error if exceptions are disabled
+ */
+void raiseError(Error &error, Error::Code code, string const &message){
+#if defined(ARGUMENTVIEWER_NO_EXCEPTIONS)
+  if (error.code != Error::NONE) return;
+  error.code    = code;
+  error.message = message;
+#else
+  (void)error;
+  if (code == Error::MATCH_ERROR) throw ex::MatchError(message);
+  throw ex::Exception(message);
+#endif
+}
+
+void ArgumentViewerImpl::raiseError(Error::Code code, string const &message) const{
+  ::raiseError(*error, code, message);
+}
+
 bool ArgumentViewerImpl::validate() const{
-  if (parent != nullptr)
-    throw ex::Exception("validation cannot be run on sub ArgumentViewer");
-  size_t index = 0;
-  return format->match(arguments, index) == Format::MATCH_SUCCESS;
+  TraceSpan span(trace.get(), "validate");
+  auto const diagnostics = diagnose();
+  if (diagnostics.empty()) return true;
+  auto const &diagnostic = diagnostics.front();
+  auto const  index      = diagnostic.index < arguments.size()
+                               ? diagnostic.index
+                               : diagnostic.argumentIndex;
+  raiseError(Error::MATCH_ERROR,
+             getDiagnosticMessage(diagnostic, arguments, syntax) +
+                 getLocation(index));
+  return false;
+}
+
+Diagnostics ArgumentViewerImpl::diagnose() const{
+  if (parent != nullptr) {
+    raiseError(Error::SUB_VIEWER_OPERATION,
+               "validation cannot be run on sub ArgumentViewer");
+    return {};
+  }
+  resolveAllIncludes();
+  auto const alf = formatCast<ArgumentListFormat>(format);
+  assert(alf != nullptr);
+  return matcher.match(*alf, arguments, layerEnds.ends);
+}
+
+Fingerprint ArgumentViewerImpl::getFingerprint() const {
+  if (parent != nullptr) {
+    raiseError(Error::SUB_VIEWER_OPERATION,
+               "fingerprint cannot be computed on sub ArgumentViewer");
+    return {};
+  }
+  resolveAllIncludes();
+  auto const alf = formatCast<ArgumentListFormat>(format);
+  assert(alf != nullptr);
+  matcher.match(*alf, arguments, layerEnds.ends);
+  return computeFingerprint(*alf, arguments, matcher.getLastMatch());
+}
+
+void ArgumentViewerImpl::writeConfiguration(
+    ostream &stream, ArgumentViewer::ConfigurationFormat configurationFormat) const {
+  if (parent != nullptr) {
+    raiseError(Error::SUB_VIEWER_OPERATION,
+               "configuration cannot be written by sub ArgumentViewer");
+    return;
+  }
+  resolveAllIncludes();
+  auto const alf = formatCast<ArgumentListFormat>(format);
+  assert(alf != nullptr);
+  matcher.match(*alf, arguments, layerEnds.ends);
+  auto const match = matcher.getLastMatch();
+  if (configurationFormat == ArgumentViewer::SNAPSHOT) {
+    auto const tokens = getConfigurationTokens(*alf, arguments, match, syntax);
+    auto const size   = ::getSnapshotSize(applicationName, tokens);
+    vector<uint64_t> memory((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    ::writeSnapshot(memory.data(), applicationName, tokens);
+    stream.write(reinterpret_cast<char const *>(memory.data()), size);
+    return;
+  }
+  vector<string> unrepresentable;
+  stringstream   ss;
+  writeConfigurationFile(ss, *alf, arguments, match, syntax, unrepresentable);
+  if (!unrepresentable.empty()) {
+    raiseError(Error::UNREPRESENTABLE_VALUE,
+               "value of argument: " + unrepresentable.front() +
+                   " cannot be written into argument file");
+    return;
+  }
+  stream << ss.str();
+}
+
+vector<string> ArgumentViewerImpl::reload() {
+  TraceSpan span(trace.get(), "reload");
+  if (parent != nullptr) {
+    raiseError(Error::SUB_VIEWER_OPERATION,
+               "reload cannot be run on sub ArgumentViewer");
+    return {};
+  }
+  ArgumentViewerImpl next;
+  next.syntax    = syntax;
+  next.missingFilesAreErrors = missingFilesAreErrors;
+  next.fileCache = std::make_shared<ArgumentFileCache>(*fileCache);
+  if (!next.fileCache->update(inputGuard ? inputGuard->getLimits().maxBytes
+                                          : ArgumentFileCache::unlimited))
+    return {};
+  next.arguments  = commandLineArguments;
+  next.provenance = commandLineProvenance;
+  next.layerEnds  = commandLineLayerEnds;
+  if (inputGuard)
+    next.inputGuard = std::make_shared<InputGuard>(inputGuard->getLimits());
+  if (next.checkTokens(next.arguments)) {
+    next.loadLayers(next.arguments, next.provenance, next.layerEnds);
+    next.checkNesting(next.arguments, 0);
+  }
+  if (next.error->code != Error::NONE) {
+    raiseError(next.error->code, next.error->message);
+    return {};
+  }
+
+  resolveAllIncludes();
+  auto const alf = formatCast<ArgumentListFormat>(format);
+  assert(alf != nullptr);
+  auto changed =
+      getChangedArguments(*alf, arguments, getContextIndex(), next.arguments,
+                          next.getContextIndex(), pathSeparator);
+  // index of contexts and the last match depend only on arguments, a file
+  // can change only its comments or formatting
+  bool const sameArguments = arguments == next.arguments &&
+                             layerEnds.ends == next.layerEnds.ends;
+  arguments.swap(next.arguments);
+  provenance = next.provenance;
+  layerEnds  = next.layerEnds;
+  fileCache  = next.fileCache;
+  inputGuard = next.inputGuard;
+  if (!sameArguments) {
+    argumentsChanged();
+    // index of new arguments is already built for comparison
+    contextIndex = std::move(next.contextIndex);
+  }
+  return changed;
 }
 
 string ArgumentViewerImpl::toStr() const {
+  TraceSpan span(trace.get(), "toStr");
   return format->toStr();
 }
 
@@ -26,212 +163,827 @@ string ArgumentViewerImpl::getApplicationName() const {
 }
 
 size_t ArgumentViewerImpl::getNofArguments() const {
+  resolveAllIncludes();
   return arguments.size();
 }
 
-bool ArgumentViewerImpl::isPresent(string const&argument,string const&com)const{
-  auto alf = std::dynamic_pointer_cast<ArgumentListFormat>(format);
-  assert(alf != nullptr);
+bool ArgumentViewerImpl::isPresent(string const&path,string const&com)const{
+  TraceSpan span(trace.get(), "read flag", path);
+  shared_ptr<ArgumentListFormat> alf;
+  string                         argument;
+  size_t                         node = ContextIndex::root;
+  if (!resolvePath(path, alf, argument, node)) return false;
 
   auto subFormatIt = alf->formats.find(argument);
   if (subFormatIt != alf->formats.end()) {
     auto subFormat = subFormatIt->second;
-    if (!isTypeOf<IsPresentFormat>(subFormat))
-      throw ex::Exception(
+    if (!isTypeOf<IsPresentFormat>(subFormat)) {
+      raiseError(
+          Error::INCOMPATIBLE_DEFINITION,
           std::string("argument: ") + argument +
-          " is already defined as something else than isPresent format");
+              " is already defined as something else than isPresent format");
+      return false;
+    }
   } else
     alf->formats[argument] = std::make_shared<IsPresentFormat>(argument, com);
   if (alf->formats[argument]->comment == "")
     alf->formats[argument]->comment = com;
 
-  return getArgumentPosition(argument) < arguments.size();
+  return getArgumentPosition(argument, node) < arguments.size();
 }
 
-shared_ptr<ArgumentViewer>ArgumentViewerImpl::getContext(string const&name,string const&com,ArgumentViewer const *_this)const{
-  auto alf = std::dynamic_pointer_cast<ArgumentListFormat>(format);
-  assert(alf != nullptr);
+shared_ptr<ArgumentViewer>ArgumentViewerImpl::getContext(string const&path,string const&com,ArgumentViewer const *_this)const{
+  TraceSpan span(trace.get(), "read context", path);
+  shared_ptr<ArgumentListFormat> alf;
+  string                         name;
+  size_t                         node     = ContextIndex::root;
+  bool const                     resolved = resolvePath(path, alf, name, node);
+  // contexts of path are nested in context of this viewer
+  size_t depth = contextDepth + 1;
+  if (pathSeparator != 0) depth += count(path.begin(), path.end(), pathSeparator);
 
   auto constructEmptyContext = [&]() {
     char const *argv[]    = {applicationName.c_str()};
     auto        result    = std::make_shared<ArgumentViewer>(1, (char **)argv);
     result->impl->parent = _this;
     result->impl->format = alf->formats[name];
+    result->impl->lazyIncludes = lazyIncludes;
+    result->impl->missingFilesAreErrors = missingFilesAreErrors;
+    result->impl->syntax       = syntax;
+    result->impl->includeTree  = includeTree;
+    result->impl->fileCache    = fileCache;
+    result->impl->trace        = trace;
+    result->impl->error        = error;
+    result->impl->pathSeparator = pathSeparator;
     return result;
   };
 
+  auto constructUnregisteredContext = [&]() {
+    auto result = constructEmptyContext();
+    result->impl->format = std::make_shared<ContextFormat>(name, com, syntax);
+    return result;
+  };
+
+  if (!resolved) return constructUnregisteredContext();
   auto subFormatIt = alf->formats.find(name);
   if (subFormatIt != alf->formats.end()) {
     auto subFormat = subFormatIt->second;
-    if (!isTypeOf<ContextFormat>(subFormat))
-      throw ex::Exception(std::string("argument: ") + name +
-                          " is already defined as something else than context");
+    if (!isTypeOf<ContextFormat>(subFormat)) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 std::string("argument: ") + name +
+                     " is already defined as something else than context");
+      return constructUnregisteredContext();
+    }
   } else
-    alf->formats[name] = std::make_shared<ContextFormat>(name, com);
+    alf->formats[name] = std::make_shared<ContextFormat>(name, com, syntax);
   if (alf->formats[name]->comment == "") alf->formats[name]->comment = com;
 
-  std::vector<std::string> subArguments;
-  if (!getContext(subArguments, name)) return constructEmptyContext();
+  size_t rangeBegin = 0, rangeEnd = 0;
+  if (!getContextRange(rangeBegin, rangeEnd, name, node))
+    return constructEmptyContext();
   char const *appName[] = {applicationName.c_str()};
   auto        result    = std::make_shared<ArgumentViewer>(1, (char **)appName);
   result->impl->parent = _this;
-  result->impl->arguments = subArguments;
+  result->impl->arguments =
+      Tokens(arguments.begin() + rangeBegin, arguments.begin() + rangeEnd);
+  result->impl->provenance.append(provenance, rangeBegin, rangeEnd);
   result->impl->format    = alf->formats.at(name);
+  result->impl->lazyIncludes = lazyIncludes;
+  result->impl->missingFilesAreErrors = missingFilesAreErrors;
+  result->impl->syntax       = syntax;
+  result->impl->includeTree  = includeTree;
+  result->impl->fileCache    = fileCache;
+  result->impl->trace        = trace;
+  result->impl->error        = error;
+  result->impl->inputGuard   = inputGuard;
+  result->impl->contextDepth = depth;
+  result->impl->pathSeparator = pathSeparator;
+  if (!layerEnds.empty())
+    result->impl->layerEnds.add(::getLayer(layerEnds, rangeBegin),
+                                rangeEnd - rangeBegin);
+  for (auto const &x : unresolvedIncludes)
+    if (x.first >= rangeBegin && x.first < rangeEnd)
+      result->impl->unresolvedIncludes[x.first - rangeBegin] = x.second;
   return result;
 }
 
-vector<string>ArgumentViewerImpl::getsv(string const&argument,vector<string>const&def,string const&com)const{
-  auto alf = std::dynamic_pointer_cast<ArgumentListFormat>(format);
-  assert(alf != nullptr);
+namespace {
+char *toArgument(string const &text) { return const_cast<char *>(text.c_str()); }
+}  // namespace
+
+vector<char *> ArgumentViewerImpl::getContextArgv(string const &path,
+                                                  string const &com,
+                                                  char const *programName) const {
+  TraceSpan span(trace.get(), "forward context", path);
+  auto const program = programName ? programName : applicationName.c_str();
+  vector<char *> result = {const_cast<char *>(program)};
+  shared_ptr<ArgumentListFormat> alf;
+  string                         name;
+  size_t                         node = ContextIndex::root;
+  size_t rangeBegin = 0, rangeEnd = 0;
+  if (resolvePath(path, alf, name, node)) {
+    auto const it = alf->formats.find(name);
+    if (it == alf->formats.end())
+      alf->formats[name] = make_shared<ForwardedContextFormat>(name, com);
+    else if (!isTypeOf<ForwardedContextFormat>(it->second))
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 std::string("argument: ") + name +
+                     " is already defined as something else than forwarded "
+                     "context");
+    if (alf->formats[name]->comment == "") alf->formats[name]->comment = com;
+    // pointers into arguments are not moved by lazy includes later
+    resolveAllIncludes();
+    if (getContextRange(rangeBegin, rangeEnd, name, node)) {
+      result.reserve(rangeEnd - rangeBegin + 2);
+      for (size_t i = rangeBegin; i < rangeEnd; ++i)
+        result.push_back(toArgument(arguments[i].text));
+    }
+  }
+  result.push_back(nullptr);
+  return result;
+}
+
+vector<char *> ArgumentViewerImpl::getArgv(size_t begin, size_t end,
+                                           char const *programName) const {
+  resolveAllIncludes();
+  auto const program = programName ? programName : applicationName.c_str();
+  end   = min(end, arguments.size());
+  begin = min(begin, end);
+  vector<char *> result;
+  result.reserve(end - begin + 2);
+  result.push_back(const_cast<char *>(program));
+  for (size_t i = begin; i < end; ++i)
+    result.push_back(toArgument(arguments[i].text));
+  result.push_back(nullptr);
+  return result;
+}
+
+vector<char *> ArgumentViewerImpl::getPassthroughArgv(
+    char const *programName) const {
+  auto const program = programName ? programName : applicationName.c_str();
+  vector<char *> result;
+  result.reserve(passthroughArguments.size() + 2);
+  result.push_back(const_cast<char *>(program));
+  for (auto const &argument : passthroughArguments)
+    result.push_back(toArgument(argument));
+  result.push_back(nullptr);
+  return result;
+}
+
+UserValue ArgumentViewerImpl::getValueWithFormat(string const &path,
+                                               Value const & def,
+                                               string const &com) const {
+  TraceSpan span(trace.get(), "read custom", path);
+  shared_ptr<ArgumentListFormat> alf;
+  string                         argument;
+  size_t                         node = ContextIndex::root;
+  if (!resolvePath(path, alf, argument, node)) return nullptr;
+
+  shared_ptr<SingleValueFormat<UserValue>> customFormat;
+  auto subFormatIt = alf->formats.find(argument);
+  if (subFormatIt != alf->formats.end()) {
+    customFormat = formatCast<SingleValueFormat<UserValue>>(subFormatIt->second);
+    if (!customFormat || !haveSameType(*customFormat->defaults, def)) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 string("argument: ") + argument +
+                     " is already defined as something else than single " +
+                     def.getType() + " value");
+      return nullptr;
+    }
+    if (!customFormat->defaults->isEqual(def)) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 string("argument: ") + argument +
+                     " has already been defined with different default value: " +
+                     customFormat->getDefaults());
+      return nullptr;
+    }
+  } else {
+    UserValue const defaults = def.clone();
+    customFormat             = make_shared<SingleValueFormat<UserValue>>(
+        argument, defaults, com, ValueParser<UserValue>(defaults));
+    alf->formats[argument] = customFormat;
+  }
+  if (customFormat->comment == "") customFormat->comment = com;
+
+  size_t const position = getArgumentPosition(argument, node);
+  if (!isInRange(position + 1, position, node)) return nullptr;
+  return customFormat->parser.parse(arguments[position + 1]);
+}
+
+vector<UserValue> ArgumentViewerImpl::getValuesWithFormat(
+    string const &path, UserValue const &prototype,
+    vector<UserValue> const &def, string const &com) const {
+  TraceSpan span(trace.get(), "read custom vector", path);
+  shared_ptr<ArgumentListFormat> alf;
+  string                         argument;
+  size_t                         node = ContextIndex::root;
+  if (!resolvePath(path, alf, argument, node)) return def;
+
+  shared_ptr<VectorFormat<UserValue>> customFormat;
+  auto subFormatIt = alf->formats.find(argument);
+  if (subFormatIt != alf->formats.end()) {
+    customFormat = formatCast<VectorFormat<UserValue>>(subFormatIt->second);
+    if (!customFormat ||
+        !haveSameType(*customFormat->parser.prototype, *prototype)) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 string("argument: ") + argument +
+                     " is already defined as something else than vector of " +
+                     prototype->getType() + " values");
+      return def;
+    }
+    if (!areEqual(customFormat->defaults, def)) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 string("argument: ") + argument +
+                     " has already been defined with different default values: " +
+                     customFormat->getDefaults());
+      return def;
+    }
+  } else {
+    customFormat = make_shared<VectorFormat<UserValue>>(
+        argument, def, com, ValueParser<UserValue>(prototype));
+    alf->formats[argument] = customFormat;
+  }
+  if (customFormat->comment == "") customFormat->comment = com;
+
+  size_t const position      = getArgumentPosition(argument, node);
+  size_t       argumentIndex = position + 1;
+  if (!isInRange(argumentIndex, position, node)) return def;
+  vector<UserValue> result;
+  while (isInRange(argumentIndex, position, node)) {
+    auto value = customFormat->parser.parse(arguments[argumentIndex++]);
+    if (!value) break;
+    result.push_back(value);
+  }
+  while (result.size() < def.size()) result.push_back(def.at(result.size()));
+  return result;
+}
+
+vector<string>ArgumentViewerImpl::getsv(string const&path,vector<string>const&def,string const&com)const{
+  TraceSpan span(trace.get(), "read vector", path, &typeName<string>);
+  shared_ptr<ArgumentListFormat> alf;
+  string                         argument;
+  size_t                         node = ContextIndex::root;
+  if (!resolvePath(path, alf, argument, node)) return def;
 
   auto subFormatIt = alf->formats.find(argument);
   if (subFormatIt != alf->formats.end()) {
     auto subFormat = subFormatIt->second;
     auto stringVectorFormat =
-        std::dynamic_pointer_cast<StringVectorFormat>(subFormat);
-    if (!stringVectorFormat)
-      throw ex::Exception(
-          std::string("argument: ") + argument +
-          " is already defined as something else than vector of string values");
-    if (stringVectorFormat->defaults != def)
-      throw ex::Exception(
-          std::string("argument: ") + argument +
-          " has already been defined with different default values: "+txtUtils::valueToString(stringVectorFormat->defaults));
+        formatCast<StringVectorFormat>(subFormat);
+    if (!stringVectorFormat) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 std::string("argument: ") + argument +
+                     " is already defined as something else than vector of "
+                     "string values");
+      return def;
+    }
+    if (stringVectorFormat->defaults != def) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 std::string("argument: ") + argument +
+                     " has already been defined with different default "
+                     "values: " +
+                     txtUtils::valueToString(stringVectorFormat->defaults));
+      return def;
+    }
   } else
     alf->formats[argument] =
-        std::make_shared<StringVectorFormat>(argument, def, com);
+        std::make_shared<StringVectorFormat>(argument, def, com, syntax);
   if (alf->formats[argument]->comment == "")
     alf->formats[argument]->comment = com;
 
+  size_t rangeBegin = 0, rangeEnd = 0;
+  if (!getContextRange(rangeBegin, rangeEnd, argument, node)) return def;
+  while (true) {
+    vector<size_t> includes;
+    for (auto include = unresolvedIncludes.lower_bound(rangeBegin);
+         include != unresolvedIncludes.end() && include->first < rangeEnd;
+         ++include)
+      includes.push_back(include->first);
+    if (includes.empty()) break;
+    size_t const oldSize = arguments.size();
+    resolveIncludes(includes);
+    rangeEnd = rangeEnd + arguments.size() - oldSize;
+  }
   std::vector<std::string> subArguments;
-  if (!getContext(subArguments, argument)) return def;
+  subArguments.reserve(max(rangeEnd - rangeBegin, def.size()));
+  for (size_t i = rangeBegin; i < rangeEnd; ++i)
+    subArguments.push_back(arguments[i].getValue());
   while (def.size() > subArguments.size())
     subArguments.push_back(def[subArguments.size()]);
-  for (auto &x : subArguments) x = parseEscapeSequence(x);
   return subArguments;
 }
 
-size_t ArgumentViewerImpl::getArgumentPosition(
+/**
+ * @brief Returns position of argument outside of contexts.
+ * Index of contexts is used when all files are loaded, lazily loaded files
+ * are loaded by the search only up to the argument.
+ *
+ * @param argument argument name
+ * @param node context of argument in index of contexts
+ *
+ * @return position or number of arguments if it is not found
+ */
+size_t ArgumentViewerImpl::getArgumentPosition(std::string const &argument,
+                                               size_t             node) const {
+  if (!unresolvedIncludes.empty()) return findArgumentPosition(argument);
+  return getContextIndex().getPosition(node, argument);
+}
+
+ContextIndex const &ArgumentViewerImpl::getContextIndex() const {
+  if (contextIndex.empty()) contextIndex.build(arguments);
+  return contextIndex;
+}
+
+void ArgumentViewerImpl::argumentsChanged() const {
+  matcher.reset();
+  contextIndex.clear();
+}
+
+/**
+ * @brief Splits path "context/context/argument" into contexts and argument.
+ * Contexts are registered as getContext registers them and they are found
+ * in index of contexts, so no context viewer is constructed.
+ * All lazily loaded files are loaded.
+ *
+ * @param path path of argument, argument without separator is in this viewer
+ * @param alf format of the last context
+ * @param argument argument name
+ * @param node the last context in index of contexts
+ *
+ * @return false if a context of path is defined as something else
+ */
+bool ArgumentViewerImpl::resolvePath(string const &                  path,
+                                     shared_ptr<ArgumentListFormat> &alf,
+                                     string &                        argument,
+                                     size_t &node) const {
+  alf = formatCast<ArgumentListFormat>(format);
+  assert(alf != nullptr);
+  argument  = path;
+  node      = ContextIndex::root;
+  auto next = pathSeparator != 0 ? path.find(pathSeparator) : string::npos;
+  if (next == string::npos) return true;
+  resolveAllIncludes();
+  size_t begin = 0;
+  for (; next != string::npos; next = path.find(pathSeparator, begin)) {
+    auto const context = path.substr(begin, next - begin);
+    auto const it      = alf->formats.find(context);
+    if (it == alf->formats.end())
+      alf->formats[context] = make_shared<ContextFormat>(context, "", syntax);
+    else if (!isTypeOf<ContextFormat>(it->second)) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 std::string("argument: ") + context +
+                     " is already defined as something else than context");
+      argument = context;
+      return false;
+    }
+    alf   = formatCast<ArgumentListFormat>(alf->formats.at(context));
+    node  = getContextIndex().getChild(node, context);
+    begin = next + 1;
+  }
+  argument = path.substr(begin);
+  return true;
+}
+
+/**
+ * @brief Finds argument among arguments with unresolved includes,
+ * includes that precede argument are resolved together and every round
+ * resolves one level of nested files
+ */
+size_t ArgumentViewerImpl::findArgumentPosition(
     std::string const &argument) const {
-  size_t       argumentIndex  = 0;
-  size_t       contextCounter = 0;
-  size_t const notFound       = arguments.size();
-  for (auto x : arguments) {
-    if (x == argument && contextCounter == 0) return argumentIndex;
-    if (x == contextBegin) ++contextCounter;
-    if (x == contextEnd) {
-      if (contextCounter == 0) return notFound;
-      --contextCounter;
+  while (true) {
+    vector<size_t> includes;
+    size_t         argumentIndex  = 0;
+    size_t         contextCounter = 0;
+    size_t         position       = arguments.size();
+    while (argumentIndex < arguments.size()) {
+      if (isUnresolvedInclude(argumentIndex)) {
+        // included files are balanced, nested ones can stay unresolved
+        if (contextCounter == 0) includes.push_back(argumentIndex);
+        argumentIndex += 2;
+        continue;
+      }
+      auto const &x = arguments[argumentIndex];
+      if (x.text == argument && contextCounter == 0) {
+        position = argumentIndex;
+        break;
+      }
+      if (x.kind == Token::CONTEXT_BEGIN) ++contextCounter;
+      if (x.kind == Token::CONTEXT_END) {
+        if (contextCounter == 0) break;
+        --contextCounter;
+      }
+      ++argumentIndex;
     }
-    ++argumentIndex;
+    if (includes.empty()) return position;
+    resolveIncludes(includes);
   }
-  return notFound;
 }
 
-bool ArgumentViewerImpl::getContext(std::vector<std::string> &contextArguments,
-                                    std::string const &       argument) const {
-  size_t argumentIndex = getArgumentPosition(argument);
-  if (!isInRange(argumentIndex++)) return false;
-  if (!isInRange(argumentIndex)) return false;
-  if (getArgument(argumentIndex++) != contextBegin) return false;
+bool ArgumentViewerImpl::getContextRange(size_t &           begin,
+                                         size_t &           end,
+                                         std::string const &argument,
+                                         size_t             node) const {
+  if (unresolvedIncludes.empty()) {
+    auto const &index   = getContextIndex();
+    auto const  context = index.getChild(node, argument);
+    if (context == ContextIndex::missing) return false;
+    begin = index.getBegin(context);
+    end   = index.getEnd(context);
+    return true;
+  }
+  size_t const position      = getArgumentPosition(argument);
+  size_t       argumentIndex = position + 1;
+  if (!isInRange(argumentIndex, position)) return false;
+  if (arguments[argumentIndex++].kind != Token::CONTEXT_BEGIN) return false;
+  begin                 = argumentIndex;
   size_t contextCounter = 0;
-  while (isInRange(argumentIndex)) {
-    if (getArgument(argumentIndex) == contextEnd) {
-      if (contextCounter == 0)
+  while (argumentIndex < arguments.size()) {
+    if (isUnresolvedInclude(argumentIndex)) {
+      argumentIndex += 2;
+      continue;
+    }
+    if (arguments[argumentIndex].kind == Token::CONTEXT_END) {
+      if (contextCounter == 0) {
+        end = argumentIndex;
         return true;
-      else
+      } else
         contextCounter--;
     }
-    if (getArgument(argumentIndex) == contextBegin)
-      contextCounter++;
-    contextArguments.push_back(getArgument(argumentIndex));
+    if (arguments[argumentIndex].kind == Token::CONTEXT_BEGIN) contextCounter++;
     ++argumentIndex;
   }
-  contextArguments.clear();
   return false;
 }
 
 
-bool ArgumentViewerImpl::isInRange(size_t index) const
+/**
+ * @brief Returns true if argument at index can be value of argument at
+ * position, values do not continue into next layer or out of context
+ *
+ * @param index index of value
+ * @param position position of argument that is read
+ * @param node context of argument in index of contexts
+ */
+bool ArgumentViewerImpl::isInRange(size_t index,
+                                   size_t position,
+                                   size_t node) const
 {
   assert(this != nullptr);
-  return index < arguments.size();
+  if (node != ContextIndex::root) return index < contextIndex.getEnd(node);
+  while (isUnresolvedInclude(index)) resolveInclude(index);
+  return index < arguments.size() && isInLayerOf(layerEnds, index, position);
 }
 
-std::string ArgumentViewerImpl::getArgument(size_t index) const
+std::string const &ArgumentViewerImpl::getArgument(size_t index) const
 {
   assert(this != nullptr);
   assert(index < arguments.size());
-  return arguments.at(index);
+  return arguments.at(index).getValue();
+}
+
+bool isFileNameMissing(Tokens const &args, size_t index) {
+  return index + 1 >= args.size();
+}
+
+void ArgumentViewerImpl::raiseMissingFileName() const {
+  raiseError(Error::MISSING_FILE_NAME, std::string("expected filename after ") +
+                                           syntax.fileSymbol +
+                                           " not end of arguments/file");
+}
+
+void ArgumentViewerImpl::raiseFileLoadingLoop(std::string const &fileName) const {
+  raiseError(Error::FILE_LOADING_LOOP,
+             std::string("file: ") + fileName + " contains file loading loop");
+}
+
+/**
+ * @brief Loads argument file within limits of input
+ *
+ * @param fileName name of argument file
+ * @param includeDepth depth of file, file included from command line has 1
+ *
+ * @return arguments of file or nullptr if it cannot be loaded or it does not
+ * exist
+ */
+Tokens const *ArgumentViewerImpl::loadArgumentFile(
+    std::string const &fileName, size_t includeDepth) const {
+  string message;
+  if (inputGuard && !inputGuard->addInclude(fileName, includeDepth, message)) {
+    raiseError(Error::LIMIT_EXCEEDED, message);
+    return nullptr;
+  }
+  // the limit is checked while the file is read, its reported size can be
+  // wrong or it can grow
+  auto const fileArguments = fileCache->getArguments(
+      fileName, inputGuard ? inputGuard->getRemainingBytes()
+                           : ArgumentFileCache::unlimited);
+  if (fileArguments == nullptr) {
+    // missing file is included as empty file unless it is an error
+    if (missingFilesAreErrors)
+      raiseError(Error::FILE_NOT_FOUND,
+                 std::string("file: ") + fileName + " cannot be loaded");
+    return nullptr;
+  }
+  if (inputGuard &&
+      !inputGuard->addBytes(fileName, fileCache->getNofReadBytes(fileName),
+                            message)) {
+    raiseError(Error::LIMIT_EXCEEDED, message);
+    return nullptr;
+  }
+  auto const error = fileCache->getError(fileName);
+  if (error != "") {
+    raiseError(Error::INVALID_JSON,
+               std::string("file: ") + fileName + " is not valid JSON: " + error);
+    return nullptr;
+  }
+  if (!checkTokens(*fileArguments)) return nullptr;
+  return fileArguments;
+}
+
+bool ArgumentViewerImpl::checkTokens(Tokens const &tokens) const {
+  string message;
+  if (!inputGuard || inputGuard->addTokens(tokens, message)) return true;
+  raiseError(Error::LIMIT_EXCEEDED, message);
+  return false;
+}
+
+bool ArgumentViewerImpl::checkNesting(Tokens const &tokens,
+                                      size_t        depth) const {
+  string message;
+  if (!inputGuard || inputGuard->checkNesting(tokens, depth, message))
+    return true;
+  raiseError(Error::LIMIT_EXCEEDED, message);
+  return false;
+}
+
+map<size_t, size_t> ArgumentViewerImpl::findIncludes(
+    Tokens const &args, size_t node) const {
+  map<size_t, size_t> includes;
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args.at(i).kind != Token::FILE_SYMBOL) continue;
+    if (isFileNameMissing(args, i)) {
+      raiseMissingFileName();
+      break;
+    }
+    includes[i++] = node;
+  }
+  return includes;
 }
 
 void ArgumentViewerImpl::loadArgumentFiles(
-    std::vector<std::string> &args, std::set<std::string> &alreadyLoaded) {
+    Tokens &args, ProvenanceMap &argsProvenance,
+    std::set<std::string> &alreadyLoaded) const {
+  auto const isFileSymbol = [](Token const &x) {
+    return x.kind == Token::FILE_SYMBOL;
+  };
+  if (none_of(args.begin(), args.end(), isFileSymbol)) return;
   size_t argumentIndex = 0;
+  Tokens result;
+  result.reserve(args.size());
+  ProvenanceMap resultProvenance;
+  // arguments from copied up to argumentIndex have not their provenance yet
+  size_t copied = 0;
   while (argumentIndex < args.size()) {
-    if (args.at(argumentIndex) != fileSymbol) {
-      ++argumentIndex;
+    if (args.at(argumentIndex).kind != Token::FILE_SYMBOL) {
+      result.push_back(std::move(args[argumentIndex++]));
       continue;
     }
-    if (argumentIndex + 1 >= args.size())
-      throw ex::Exception(std::string("expected filename after ") + fileSymbol +
-                          " not end of arguments/file");
-    auto fileName = args.at(argumentIndex + 1);
+    if (isFileNameMissing(args, argumentIndex)) {
+      raiseMissingFileName();
+      break;
+    }
+    auto fileName = args.at(argumentIndex + 1).text;
+    Tokens newArgs;
+    ProvenanceMap newProvenance;
     if (alreadyLoaded.count(fileName))
-      throw ex::Exception(std::string("file: ") + fileName +
-                          " contains file loading loop");
-    std::vector<std::string> newArgs;
-    std::string              fileContent = txtUtils::loadTextFile(fileName);
-    splitFileToArguments(newArgs, fileContent);
-    alreadyLoaded.insert(fileName);
-    loadArgumentFiles(newArgs, alreadyLoaded);
-    alreadyLoaded.erase(fileName);
-    std::vector<std::string> withLoadedFile;
-    for (size_t j = 0; j < argumentIndex; ++j)
-      withLoadedFile.push_back(args.at(j));
-    for (auto const &x : newArgs) withLoadedFile.push_back(x);
-    for (size_t j = argumentIndex + 2; j < args.size(); ++j)
-      withLoadedFile.push_back(args.at(j));
-    args = withLoadedFile;
-    argumentIndex--;
-    argumentIndex += newArgs.size();
-  }
-}
-
-void ArgumentViewerImpl::splitFileToArguments(std::vector<std::string> &args,
-                                              std::string const &fileContent) {
-  mealyMachine::MealyMachine mm;
-  auto                       start        = mm.addState();
-  auto                       space        = mm.addState();
-  auto                       word         = mm.addState();
-  auto                       comment      = mm.addState();
-  auto                       startNewWord = [&](mealyMachine::MealyMachine *) {
-    args.push_back("");
-    args.back() += *(char *)mm.getCurrentSymbol();
-  };
-  auto addCharToWord = [&](mealyMachine::MealyMachine *) {
-    args.back() += *(char *)mm.getCurrentSymbol();
-  };
-  mm.addTransition(start, " \t\n\r", space);
-  mm.addTransition(start, "#", comment);
-  mm.addElseTransition(start, word, startNewWord);
-  mm.addEOFTransition(start);
+      raiseFileLoadingLoop(fileName);
+    else if (auto const fileArguments =
+                 loadArgumentFile(fileName, alreadyLoaded.size() + 1)) {
+      newArgs       = *fileArguments;
+      newProvenance = ProvenanceMap(fileCache->getSource(fileName), newArgs.size());
+      alreadyLoaded.insert(fileName);
+      loadArgumentFiles(newArgs, newProvenance, alreadyLoaded);
+      alreadyLoaded.erase(fileName);
+    }
+    resultProvenance.append(argsProvenance, copied, argumentIndex);
+    resultProvenance.append(newProvenance);
+    copied = argumentIndex + 2;
+    // loaded arguments are already resolved, they are moved to result
+    // directly, so every argument is copied only once
+    result.insert(result.end(), make_move_iterator(newArgs.begin()),
+                  make_move_iterator(newArgs.end()));
+    argumentIndex += 2;
+  }
+  result.insert(result.end(), make_move_iterator(args.begin() + argumentIndex),
+                make_move_iterator(args.end()));
+  args.swap(result);
+  resultProvenance.append(argsProvenance, copied, argsProvenance.size());
+  argsProvenance = resultProvenance;
+}
+
+/**
+ * @brief Loads argument files of every layer separately, so a file loading
+ * loop is detected within a layer and ends of layers move by sizes of files
+ *
+ * @param args arguments of all layers
+ * @param argsProvenance provenance of arguments
+ * @param ends ends of layers, empty if there is only command line
+ */
+void ArgumentViewerImpl::loadLayers(Tokens &          args,
+                                    ProvenanceMap &   argsProvenance,
+                                    LayerEnds &       ends) const {
+  if (ends.empty()) {
+    std::set<std::string> alreadyLoaded;
+    loadArgumentFiles(args, argsProvenance, alreadyLoaded);
+    return;
+  }
+  Tokens        result;
+  ProvenanceMap resultProvenance;
+  size_t        begin = 0;
+  for (auto &end : ends.ends) {
+    Tokens layerArgs(make_move_iterator(args.begin() + begin),
+                     make_move_iterator(args.begin() + end));
+    ProvenanceMap layerProvenance;
+    layerProvenance.append(argsProvenance, begin, end);
+    std::set<std::string> alreadyLoaded;
+    loadArgumentFiles(layerArgs, layerProvenance, alreadyLoaded);
+    begin = end;
+    result.insert(result.end(), make_move_iterator(layerArgs.begin()),
+                  make_move_iterator(layerArgs.end()));
+    resultProvenance.append(layerProvenance);
+    end = result.size();
+  }
+  args.swap(result);
+  argsProvenance = resultProvenance;
+}
+
+/**
+ * @brief Returns layer of the value of argument
+ *
+ * @param path path of argument
+ *
+ * @return layer of the first occurrence of argument or DEFAULT
+ */
+Layers::Layer ArgumentViewerImpl::getLayer(string const &path) const {
+  size_t node     = ContextIndex::root;
+  string argument = path;
+  auto   next = pathSeparator != 0 ? path.find(pathSeparator) : string::npos;
+  if (next != string::npos) resolveAllIncludes();
+  size_t begin = 0;
+  for (; next != string::npos; next = path.find(pathSeparator, begin)) {
+    node     = getContextIndex().getChild(node, path.substr(begin, next - begin));
+    begin    = next + 1;
+    argument = path.substr(begin);
+  }
+  auto const position = getArgumentPosition(argument, node);
+  if (position >= arguments.size()) return Layers::DEFAULT;
+  return ::getLayer(layerEnds, position);
+}
 
-  mm.addTransition(space, " \t\n\r", space);
-  mm.addTransition(space, "#", comment);
-  mm.addElseTransition(space, word, startNewWord);
-  mm.addEOFTransition(space);
+Provenance ArgumentViewerImpl::getProvenance(size_t index) const {
+  Provenance         result;
+  TokenSource const *source      = nullptr;
+  size_t             sourceIndex = 0;
+  if (!provenance.get(index, source, sourceIndex) || !source) return result;
+  result.file = source->name;
+  source->positions.get(sourceIndex, result.line, result.column);
+  return result;
+}
 
-  mm.addTransition(comment, "\n\r", start);
-  mm.addElseTransition(comment, comment);
-  mm.addEOFTransition(comment);
+/**
+ * @brief Describes where argument comes from, it is used in error messages
+ *
+ * @param index index of argument
+ *
+ * @return " in file: name line: l column: c" or
+ * " in command line argument: i", empty if origin is not known
+ */
+string ArgumentViewerImpl::getLocation(size_t index) const {
+  if (index >= provenance.size()) return "";
+  auto const origin = getProvenance(index);
+  stringstream ss;
+  if (origin.file == "")
+    ss << " in command line argument: " << origin.column;
+  else if (origin.line == 0)
+    ss << " in environment variable: " << origin.file;
+  else
+    ss << " in file: " << origin.file << " line: " << origin.line
+       << " column: " << origin.column;
+  return ss.str();
+}
 
-  mm.addTransition(word, " \t\n\r", space);
-  mm.addTransition(word, "#", comment);
-  mm.addElseTransition(word, word, addCharToWord);
-  mm.addEOFTransition(word);
+void ArgumentViewerImpl::deferArgumentFiles(Tokens const &args) {
+  lazyIncludes       = true;
+  includeTree        = std::make_shared<IncludeTree>();
+  unresolvedIncludes = findIncludes(args, IncludeTree::root);
+}
 
-  mm.match(fileContent.c_str());
+bool ArgumentViewerImpl::isUnresolvedInclude(size_t index) const {
+  if (unresolvedIncludes.empty()) return false;
+  return unresolvedIncludes.count(index) != 0;
 }
 
+void ArgumentViewerImpl::resolveInclude(size_t index) const {
+  resolveIncludes({index});
+}
+
+/**
+ * @brief Replaces unresolved includes by arguments of their files,
+ * arguments, provenance, layers and includes are rebuilt once for all of them
+ * and includes found in loaded files stay unresolved
+ *
+ * @param indices increasing positions of unresolved includes
+ */
+void ArgumentViewerImpl::resolveIncludes(vector<size_t> const &indices) const {
+  struct LoadedFile {
+    size_t              index;
+    string              fileName;
+    Tokens const *      arguments;
+    map<size_t, size_t> includes;
+  };
+  static Tokens const noArguments;
+  bool const          limitsNesting = inputGuard && inputGuard->limitsNesting();
+  vector<LoadedFile>  files;
+  files.reserve(indices.size());
+  size_t depth = contextDepth, scanned = 0;
+  for (auto const index : indices) {
+    assert(isUnresolvedInclude(index));
+    if (limitsNesting) {
+      depth   = InputGuard::getNestingDepth(arguments, scanned, index, depth);
+      scanned = index;
+    }
+    LoadedFile file{index, arguments.at(index + 1).text, &noArguments, {}};
+    auto const parentNode = unresolvedIncludes.at(index);
+    if (includeTree->isLoadedBy(parentNode, file.fileName))
+      raiseFileLoadingLoop(file.fileName);
+    else if (auto const fileArguments = loadArgumentFile(
+                 file.fileName, includeTree->getDepth(parentNode) + 1)) {
+      if (checkNesting(*fileArguments, limitsNesting ? depth : 0)) {
+        file.arguments = fileArguments;
+        file.includes  = findIncludes(
+            *fileArguments, includeTree->addFile(parentNode, file.fileName));
+      }
+    }
+    files.push_back(std::move(file));
+  }
+
+  size_t newSize = arguments.size();
+  for (auto const &file : files) newSize = newSize + file.arguments->size() - 2;
+  Tokens              newArguments;
+  ProvenanceMap       newProvenance;
+  map<size_t, size_t> newIncludes;
+  newArguments.reserve(newSize);
+  auto   include = unresolvedIncludes.cbegin();
+  size_t copied  = 0;
+  auto const copyUntil = [&](size_t end) {
+    for (; include != unresolvedIncludes.cend() && include->first < end;
+         ++include)
+      newIncludes.emplace_hint(newIncludes.end(),
+                               newArguments.size() + include->first - copied,
+                               include->second);
+    newArguments.insert(newArguments.end(),
+                        std::make_move_iterator(arguments.begin() + copied),
+                        std::make_move_iterator(arguments.begin() + end));
+    newProvenance.append(provenance, copied, end);
+    copied = end;
+  };
+  for (auto const &file : files) {
+    copyUntil(file.index);
+    ++include;
+    for (auto const &x : file.includes)
+      newIncludes.emplace_hint(
+          newIncludes.end(), newArguments.size() + x.first, x.second);
+    newArguments.insert(
+        newArguments.end(), file.arguments->begin(), file.arguments->end());
+    newProvenance.append(ProvenanceMap(fileCache->getSource(file.fileName),
+                                       file.arguments->size()));
+    copied = file.index + 2;
+  }
+  copyUntil(arguments.size());
 
+  auto   file  = files.cbegin();
+  size_t shift = 0;
+  for (auto &end : layerEnds.ends) {
+    for (; file != files.cend() && file->index < end; ++file)
+      shift = shift + file->arguments->size() - 2;
+    end += shift;
+  }
+  arguments          = std::move(newArguments);
+  provenance         = std::move(newProvenance);
+  unresolvedIncludes = std::move(newIncludes);
+  argumentsChanged();
+}
+
+/**
+ * @brief Resolves includes level by level, every level is one pass over
+ * arguments
+ */
+void ArgumentViewerImpl::resolveAllIncludes() const {
+  while (!unresolvedIncludes.empty()) {
+    vector<size_t> indices;
+    indices.reserve(unresolvedIncludes.size());
+    for (auto const &x : unresolvedIncludes) indices.push_back(x.first);
+    resolveIncludes(indices);
+  }
+}
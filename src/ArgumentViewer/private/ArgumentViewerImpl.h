@@ -1,105 +1,213 @@
 #pragma once
 
-#include <ArgumentViewer/Exception.h>
+#include <ArgumentViewer/ArgumentViewer.h>
+#include <ArgumentViewer/Error.h>
 #include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/Provenance.h>
+#include <ArgumentViewer/private/ArgumentFileCache.h>
 #include <ArgumentViewer/private/ArgumentListFormat.h>
 #include <ArgumentViewer/private/CommonFunctions.h>
+#include <ArgumentViewer/private/ContextIndex.h>
+#include <ArgumentViewer/private/ValueParser.h>
 #include <ArgumentViewer/private/Format.h>
+#include <ArgumentViewer/private/IncludeTree.h>
+#include <ArgumentViewer/private/IncrementalMatcher.h>
+#include <ArgumentViewer/private/InputGuard.h>
+#include <ArgumentViewer/private/Layers.h>
+#include <ArgumentViewer/private/Provenance.h>
 #include <ArgumentViewer/private/SingleValueFormat.h>
+#include <ArgumentViewer/private/TraceImpl.h>
 #include <ArgumentViewer/private/VectorFormat.h>
 #include <TxtUtils/TxtUtils.h>
+#include <algorithm>
 #include <cassert>
+#include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <sstream>
 
 using namespace argumentViewer;
 
+void raiseError(Error &error, Error::Code code, string const &message);
+
 class argumentViewer::ArgumentViewerImpl {
  public:
   string                applicationName = "";
-  vector<string>        arguments;
+  Tokens                commandLineArguments;
+  mutable Tokens        arguments;
+  // origin of every argument, it is changed together with arguments
+  mutable ProvenanceMap provenance;
+  ProvenanceMap         commandLineProvenance;
+  // layers of arguments, empty if there is only command line
+  mutable LayerEnds     layerEnds;
+  LayerEnds             commandLineLayerEnds;
+  // command line arguments after passthrough terminator, they are not matched
+  vector<string>           passthroughArguments;
   ArgumentViewer const *parent = nullptr;
   shared_ptr<Format>    format = nullptr;
+  bool                  lazyIncludes = false;
+  bool                  missingFilesAreErrors = false;
+  Syntax                syntax;
+  shared_ptr<IncludeTree> includeTree = nullptr;
+  shared_ptr<ArgumentFileCache> fileCache = make_shared<ArgumentFileCache>();
+  shared_ptr<Error>     error = make_shared<Error>();
+  shared_ptr<TraceImpl> trace = nullptr;
+  // it is shared with context viewers, nullptr if there is nothing to read
+  shared_ptr<InputGuard> inputGuard = nullptr;
+  // number of contexts that contain arguments of this viewer
+  size_t                contextDepth = 0;
+  // position of unresolved "<" -> include tree node of file that contains it
+  mutable map<size_t, size_t> unresolvedIncludes;
+  // result of the last diagnose(), it is reused by the next one
+  mutable IncrementalMatcher matcher;
+  // positions of arguments in all contexts, it is built by the first lookup
+  // after arguments changed, when all files are loaded
+  mutable ContextIndex contextIndex;
+  // separator of contexts in paths of arguments, 0 if paths are not used
+  char                 pathSeparator = 0;
+  void raiseError(Error::Code code, string const &message) const;
   bool validate()const;
+  Diagnostics diagnose()const;
+  vector<char *> getContextArgv(string const &path, string const &com,
+                                char const *programName) const;
+  vector<char *> getArgv(size_t begin, size_t end,
+                         char const *programName) const;
+  vector<char *> getPassthroughArgv(char const *programName) const;
+  Fingerprint getFingerprint()const;
+  void writeConfiguration(ostream&stream,ArgumentViewer::ConfigurationFormat format)const;
+  vector<string> reload();
   string toStr()const;
   string getApplicationName()const;
   size_t getNofArguments()const;
-  bool isPresent(string const&argument,string const&com)const;
-  shared_ptr<ArgumentViewer>getContext(string const&name,string const&com,ArgumentViewer const*_this)const;
-  size_t                getArgumentPosition(string const &argument) const;
-  bool                  getContext(vector<string> &contextArguments,
-                                   string const &  argument) const;
-  vector<string>        getsv(string const&argument,vector<string>const&def,string const&com)const;
-  bool                  isInRange(size_t index) const;
-  string                getArgument(size_t index) const;
-  void loadArgumentFiles(vector<string> &args, set<string> &alreadyLoaded);
-  void splitFileToArguments(vector<string> &args, string const &fileContent);
+  bool isPresent(string const&path,string const&com)const;
+  shared_ptr<ArgumentViewer>getContext(string const&path,string const&com,ArgumentViewer const*_this)const;
+  size_t                getArgumentPosition(string const &argument,
+                                        size_t node = ContextIndex::root) const;
+  ContextIndex const &  getContextIndex() const;
+  bool                  resolvePath(string const &                  path,
+                                    shared_ptr<ArgumentListFormat> &alf,
+                                    string &                        argument,
+                                    size_t &                        node) const;
+  size_t                findArgumentPosition(string const &argument) const;
+  void                  argumentsChanged() const;
+  bool                  getContextRange(size_t &      begin,
+                                        size_t &      end,
+                                        string const &argument,
+                                        size_t node = ContextIndex::root) const;
+  vector<string>        getsv(string const&path,vector<string>const&def,string const&com)const;
+  bool                  isInRange(size_t index,
+                                  size_t position,
+                                  size_t node = ContextIndex::root) const;
+  string const &        getArgument(size_t index) const;
+  void raiseMissingFileName() const;
+  void raiseFileLoadingLoop(string const &fileName) const;
+  Tokens const *       loadArgumentFile(string const &fileName,
+                                        size_t        includeDepth) const;
+  bool                  checkTokens(Tokens const &tokens) const;
+  bool                  checkNesting(Tokens const &tokens, size_t depth) const;
+  map<size_t, size_t>   findIncludes(Tokens const &args, size_t node) const;
+  void loadArgumentFiles(Tokens &       args,
+                         ProvenanceMap &argsProvenance,
+                         set<string> &  alreadyLoaded) const;
+  void       loadLayers(Tokens &          args,
+                        ProvenanceMap &   argsProvenance,
+                        LayerEnds &       ends) const;
+  Layers::Layer getLayer(string const &path) const;
+  Provenance getProvenance(size_t index) const;
+  string     getLocation(size_t index) const;
+  void deferArgumentFiles(Tokens const &args);
+  bool isUnresolvedInclude(size_t index) const;
+  void resolveInclude(size_t index) const;
+  void resolveIncludes(vector<size_t> const &indices) const;
+  void resolveAllIncludes() const;
 
+  UserValue         getValueWithFormat(string const &path,
+                                       Value const & def,
+                                       string const &com) const;
+  vector<UserValue> getValuesWithFormat(string const &           path,
+                                        UserValue const &        prototype,
+                                        vector<UserValue> const &def,
+                                        string const &           com) const;
   template <typename TYPE>
-  TYPE getArgument(string const &argument, TYPE const &def) const;
+  TYPE getArgument(string const &argument, TYPE const &def, size_t node) const;
   template <typename TYPE>
   vector<TYPE> getArguments(string const &      argument,
-                            vector<TYPE> const &def) const;
+                            vector<TYPE> const &def,
+                            size_t              node) const;
   template <typename TYPE>
-  TYPE getArgumentWithFormat(string const &argument,
+  TYPE getArgumentWithFormat(string const &path,
                              TYPE const &  def,
                              string const &com) const;
   template <typename TYPE>
-  vector<TYPE> getArgumentsWithFormat(string const &      argument,
+  vector<TYPE> getArgumentsWithFormat(string const &      path,
                                       vector<TYPE> const &def,
                                       string const &      com) const;
 };
 
 template <typename TYPE>
 TYPE ArgumentViewerImpl::getArgument(string const &argument,
-                                     TYPE const &  def) const
+                                     TYPE const &  def,
+                                     size_t        node) const
 {
-  size_t i = getArgumentPosition(argument);
-  if (!isInRange(i++)) return def;
-  if (!isInRange(i)) return def;
-  auto value = getArgument(i);
+  size_t const position = getArgumentPosition(argument, node);
+  if (!isInRange(position + 1, position, node)) return def;
+  auto const &value = getArgument(position + 1);
   if (!isValueConvertibleTo<TYPE>(value)) return def;
   return str2val<TYPE>(value);
 }
 
 template <typename TYPE>
 vector<TYPE> ArgumentViewerImpl::getArguments(string const &      argument,
-                                              vector<TYPE> const &def) const
+                                              vector<TYPE> const &def,
+                                              size_t              node) const
 {
-  size_t argumentIndex = getArgumentPosition(argument);
-  if (!isInRange(argumentIndex++)) return def;
-  if (!isInRange(argumentIndex)) return def;
+  size_t const position      = getArgumentPosition(argument, node);
+  size_t       argumentIndex = position + 1;
+  if (!isInRange(argumentIndex, position, node)) return def;
+  // values are counted first, result is allocated once
+  size_t end = argumentIndex;
+  while (isInRange(end, position, node) &&
+         isValueConvertibleTo<TYPE>(getArgument(end)))
+    ++end;
   vector<TYPE> result;
-  while (isInRange(argumentIndex) &&
-         isValueConvertibleTo<TYPE>(getArgument(argumentIndex)))
-    result.push_back(txtUtils::str2Value<TYPE>(getArgument(argumentIndex++)));
+  result.reserve(max(end - argumentIndex, def.size()));
+  for (; argumentIndex < end; ++argumentIndex)
+    result.push_back(txtUtils::str2Value<TYPE>(getArgument(argumentIndex)));
   while (result.size() < def.size()) result.push_back(def.at(result.size()));
   return result;
 }
 
 template <typename TYPE>
-TYPE ArgumentViewerImpl::getArgumentWithFormat(string const &argument,
+TYPE ArgumentViewerImpl::getArgumentWithFormat(string const &path,
                                                TYPE const &  def,
                                                string const &com) const
 {
-  auto alf = dynamic_pointer_cast<ArgumentListFormat>(format);
-  assert(alf != nullptr);
+  TraceSpan span(trace.get(), "read", path, &typeName<TYPE>);
+  shared_ptr<ArgumentListFormat> alf;
+  string                         argument;
+  size_t                         node = ContextIndex::root;
+  if (!resolvePath(path, alf, argument, node)) return def;
 
   auto subFormatIt = alf->formats.find(argument);
   if (subFormatIt != alf->formats.end()) {
     auto subFormat = subFormatIt->second;
     auto singleValueFormat =
-        dynamic_pointer_cast<SingleValueFormat<TYPE>>(subFormat);
-    if (!singleValueFormat)
-      throw ex::Exception(string("argument: ") + argument +
-                          " is already defined as something else than single " +
-                          typeName<TYPE>() + " value");
-    if (singleValueFormat->defaults != def)
-      throw ex::Exception(
-          string("argument: ") + argument +
-          " has already been defined with different default value: " +
-          txtUtils::valueToString(singleValueFormat->defaults));
+        formatCast<SingleValueFormat<TYPE>>(subFormat);
+    if (!singleValueFormat) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 string("argument: ") + argument +
+                     " is already defined as something else than single " +
+                     typeName<TYPE>() + " value");
+      return def;
+    }
+    if (singleValueFormat->defaults != def) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 string("argument: ") + argument +
+                     " has already been defined with different default value: " +
+                     txtUtils::valueToString(singleValueFormat->defaults));
+      return def;
+    }
   }
   else
     alf->formats[argument] =
@@ -107,31 +215,38 @@ TYPE ArgumentViewerImpl::getArgumentWithFormat(string const &argument,
   if (alf->formats[argument]->comment == "")
     alf->formats[argument]->comment = com;
 
-  return getArgument<TYPE>(argument, def);
+  return getArgument<TYPE>(argument, def, node);
 }
 
 template <typename TYPE>
-vector<TYPE> ArgumentViewerImpl::getArgumentsWithFormat(string const &argument,
+vector<TYPE> ArgumentViewerImpl::getArgumentsWithFormat(string const &path,
                                                         vector<TYPE> const &def,
                                                         string const &com) const
 {
-  auto alf = dynamic_pointer_cast<ArgumentListFormat>(format);
-  assert(alf != nullptr);
+  TraceSpan span(trace.get(), "read vector", path, &typeName<TYPE>);
+  shared_ptr<ArgumentListFormat> alf;
+  string                         argument;
+  size_t                         node = ContextIndex::root;
+  if (!resolvePath(path, alf, argument, node)) return def;
 
   auto subFormatIt = alf->formats.find(argument);
   if (subFormatIt != alf->formats.end()) {
     auto subFormat    = subFormatIt->second;
-    auto vectorFormat = dynamic_pointer_cast<VectorFormat<TYPE>>(subFormat);
-    if (!vectorFormat)
-      throw ex::Exception(
-          string("argument: ") + argument +
-          " is already defined as something else than vector of " +
-          typeName<TYPE>() + " values");
-    if (vectorFormat->defaults != def)
-      throw ex::Exception(
-          string("argument: ") + argument +
-          " has already been defined with different default values: " +
-          txtUtils::valueToString(vectorFormat->defaults));
+    auto vectorFormat = formatCast<VectorFormat<TYPE>>(subFormat);
+    if (!vectorFormat) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 string("argument: ") + argument +
+                     " is already defined as something else than vector of " +
+                     typeName<TYPE>() + " values");
+      return def;
+    }
+    if (vectorFormat->defaults != def) {
+      raiseError(Error::INCOMPATIBLE_DEFINITION,
+                 string("argument: ") + argument +
+                     " has already been defined with different default values: " +
+                     txtUtils::valueToString(vectorFormat->defaults));
+      return def;
+    }
   }
   else
     alf->formats[argument] =
@@ -139,5 +254,5 @@ vector<TYPE> ArgumentViewerImpl::getArgumentsWithFormat(string const &argument,
   if (alf->formats[argument]->comment == "")
     alf->formats[argument]->comment = com;
 
-  return getArguments<TYPE>(argument, def);
+  return getArguments<TYPE>(argument, def, node);
 }
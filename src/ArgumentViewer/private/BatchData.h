@@ -0,0 +1,19 @@
+#pragma once
+
+#include <ArgumentViewer/Error.h>
+#include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/Syntax.h>
+#include <ArgumentViewer/private/ArgumentListFormat.h>
+
+/**
+ * @brief Registered arguments shared by all threads of Batch
+ */
+struct argumentViewer::BatchData {
+  shared_ptr<ArgumentListFormat const> format;
+  Syntax                               syntax;
+  // error of viewer that registered arguments
+  shared_ptr<Error> error;
+  size_t            nofThreads = 1;
+  // number of lines that a thread takes at once
+  static size_t const blockSize = 64;
+};
@@ -0,0 +1,120 @@
+#include <ArgumentViewer/private/ChangedArguments.h>
+#include <ArgumentViewer/private/CommonFunctions.h>
+#include <ArgumentViewer/private/ContextFormat.h>
+#include <algorithm>
+
+namespace {
+struct ArgumentRange {
+  size_t begin = 0;
+  size_t end   = 0;
+};
+
+/**
+ * @brief Arguments of one version of arguments and their index of contexts
+ */
+struct IndexedArguments {
+  Tokens const &      args;
+  ContextIndex const &index;
+};
+
+/**
+ * @brief Returns range of argument and its value in context, the value ends
+ * where format stops matching it, invalid value ends after the first token
+ * that does not match
+ */
+ArgumentRange getValueRange(Format const &          format,
+                            IndexedArguments const &arguments,
+                            size_t                  node,
+                            string const &          argument)
+{
+  ArgumentRange range;
+  size_t const  end = arguments.index.getEnd(node);
+  range.begin       = arguments.index.getPosition(node, argument);
+  if (range.begin >= end) {
+    range.begin = range.end = 0;
+    return range;
+  }
+  range.end = range.begin;
+  Diagnostics diagnostics;
+  format.match(arguments.args, range.end, diagnostics);
+  if (!diagnostics.empty()) ++range.end;
+  range.end = min(max(range.end, range.begin + 1), end);
+  return range;
+}
+
+bool areEqual(IndexedArguments const &a,
+              ArgumentRange const &   aRange,
+              IndexedArguments const &b,
+              ArgumentRange const &   bRange)
+{
+  return aRange.end - aRange.begin == bRange.end - bRange.begin &&
+         equal(a.args.begin() + aRange.begin, a.args.begin() + aRange.end,
+               b.args.begin() + bRange.begin);
+}
+
+void getChangedArguments(vector<string> &          changed,
+                         string const &            prefix,
+                         char                      separator,
+                         ArgumentListFormat const &format,
+                         IndexedArguments const &  oldArgs,
+                         size_t                    oldNode,
+                         IndexedArguments const &  newArgs,
+                         size_t                    newNode)
+{
+  for (auto const &x : format.formats) {
+    auto const name = prefix + x.first;
+    if (isTypeOf<ContextFormat>(x.second)) {
+      auto const oldContext = oldArgs.index.getChild(oldNode, x.first);
+      auto const newContext = newArgs.index.getChild(newNode, x.first);
+      bool const oldFound   = oldContext != ContextIndex::missing;
+      bool const newFound   = newContext != ContextIndex::missing;
+      if (oldFound != newFound) changed.push_back(name);
+      if (!oldFound || !newFound) continue;
+      auto const &contextFormat = *formatCast<ContextFormat>(x.second);
+      if (separator != 0) {
+        getChangedArguments(changed, name + separator, separator, contextFormat,
+                            oldArgs, oldContext, newArgs, newContext);
+        continue;
+      }
+      // without paths, context is reported instead of its arguments
+      vector<string> changedInContext;
+      getChangedArguments(changedInContext, "", separator, contextFormat,
+                          oldArgs, oldContext, newArgs, newContext);
+      if (!changedInContext.empty()) changed.push_back(name);
+      continue;
+    }
+    if (!areEqual(oldArgs, getValueRange(*x.second, oldArgs, oldNode, x.first),
+                  newArgs, getValueRange(*x.second, newArgs, newNode, x.first)))
+      changed.push_back(name);
+  }
+}
+}  // namespace
+
+/**
+ * @brief Compares values of all registered arguments, arguments are found
+ * by indices of contexts, so every argument is compared only once
+ *
+ * @param format format of arguments
+ * @param oldArgs arguments before change
+ * @param oldIndex index of contexts of oldArgs
+ * @param newArgs arguments after change
+ * @param newIndex index of contexts of newArgs
+ * @param separator separator of contexts in names, 0 if paths are not used
+ *
+ * @return names of arguments whose value differs, arguments inside contexts
+ * are prefixed by context names separated by separator, if there is no
+ * separator, context is reported instead of its arguments
+ */
+vector<string> getChangedArguments(ArgumentListFormat const &format,
+                                   Tokens const &            oldArgs,
+                                   ContextIndex const &      oldIndex,
+                                   Tokens const &            newArgs,
+                                   ContextIndex const &      newIndex,
+                                   char                      separator)
+{
+  vector<string> changed;
+  getChangedArguments(changed, "", separator, format, {oldArgs, oldIndex},
+                      ContextIndex::root, {newArgs, newIndex},
+                      ContextIndex::root);
+  return changed;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <ArgumentViewer/private/ArgumentListFormat.h>
+#include <ArgumentViewer/private/ContextIndex.h>
+
+vector<string> getChangedArguments(ArgumentListFormat const &format,
+                                   Tokens const &            oldArgs,
+                                   ContextIndex const &      oldIndex,
+                                   Tokens const &            newArgs,
+                                   ContextIndex const &      newIndex,
+                                   char                      separator);
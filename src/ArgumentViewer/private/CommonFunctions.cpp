@@ -1,12 +1,4 @@
 #include <ArgumentViewer/private/CommonFunctions.h>
-#include <ArgumentViewer/private/Globals.h>
-
-string parseEscapeSequence(string const &text) {
-  if (text == "\\" + contextBegin) return contextBegin;
-  if (text == "\\" + contextEnd) return contextEnd;
-  if (text == "\\" + fileSymbol) return fileSymbol;
-  return text;
-}
 
 string alignString(string const &text,
                    size_t        alignment,
@@ -1,12 +1,12 @@
 #pragma once
 
 #include <TxtUtils/TxtUtils.h>
+#include <limits>
+#include <sstream>
 #include <string>
 
 using namespace std;
 
-string parseEscapeSequence(string const &text);
-
 string alignString(string const &text,
                    size_t        alignment  = 0,
                    char          filler     = ' ',
@@ -20,12 +20,6 @@ string extractSubstring(string const&str,size_t start,size_t end);
 
 std::vector<string>splitString(string const&txt,string const&splitter);
 
-template <typename TO, typename FROM>
-bool isTypeOf(shared_ptr<FROM> const &value)
-{
-  return dynamic_pointer_cast<TO>(value) != nullptr;
-}
-
 template <typename TYPE>
 string typeName();
 
@@ -88,3 +82,33 @@ TYPE str2val(std::string const &value)
 {
   return value;
 }
+
+/**
+ * @brief Converts value to text that is the same for all texts of the value.
+ * Floating point values are written with all digits so str2val gives back
+ * the same value.
+ */
+template <typename TYPE,
+          typename std::enable_if<std::is_floating_point<TYPE>::value,
+                                  unsigned>::type = 0>
+std::string val2canonical(TYPE const &value)
+{
+  std::ostringstream ss;
+  ss.precision(std::numeric_limits<TYPE>::max_digits10);
+  ss << value;
+  return ss.str();
+}
+template <typename TYPE,
+          typename std::enable_if<std::is_integral<TYPE>::value,
+                                  unsigned>::type = 0>
+std::string val2canonical(TYPE const &value)
+{
+  return std::to_string(value);
+}
+template <typename TYPE,
+          typename std::enable_if<std::is_same<TYPE, std::string>::value,
+                                  unsigned>::type = 0>
+std::string val2canonical(TYPE const &value)
+{
+  return value;
+}
@@ -1,69 +1,43 @@
-#include <ArgumentViewer/Exception.h>
 #include <ArgumentViewer/private/ContextFormat.h>
+#include <ArgumentViewer/private/IncrementalMatcher.h>
 #include <set>
 
-using namespace argumentViewer::ex;
+using namespace argumentViewer;
 
 ContextFormat::ContextFormat(string const &argument,
-                             string const &com)
-    : ArgumentListFormat(com), argumentName(argument) {}
+                             string const &com,
+                             Syntax const &s)
+    : ArgumentListFormat(com), argumentName(argument), syntax(s) {}
 
 string ContextFormat::toStr(size_t indent, size_t, size_t, size_t) const {
   stringstream ss;
-  for (size_t i = 0; i < indent; ++i) ss << " ";
-  ss << argumentName << " ";
-  ss << contextBegin << " - " << comment << endl;
-  ss << ArgumentListFormat::toStr(indent + 2);
-  for (size_t i = 0; i < indent; ++i) ss << " ";
-  ss << contextEnd << endl;
+  writeBegin(ss, indent);
+  writeHierarchy(ss, indent + 2);
+  writeEnd(ss, indent);
   return ss.str();
 }
 
-void throwIfIndexIsOutOfRange(vector<string> const &args,size_t &index,string const&argumentName){
-  if (index < args.size()) return;
-  stringstream ss;
-  ss << "Argument error:" << endl;
-  ss << "expected " << contextBegin
-     << " after context argument: " << argumentName;
-  ss << " not end of arguments";
-  throw MatchError(ss.str());
-}
-
-void throwIfArgumentIsNotContextBegin(vector<string> const &args,size_t &index,string const&argumentName){
-  if (args.at(index) == contextBegin) return;
-  stringstream ss;
-  ss << "Argument error:" << endl;
-  ss << "expected " << contextBegin
-     << " after context argument: " << argumentName;
-  ss << " not: " << args.at(index);
-  throw MatchError(ss.str());
+void ContextFormat::writeBegin(stringstream &ss, size_t indent) const {
+  writeIndentation(ss, indent);
+  ss << argumentName << " ";
+  ss << syntax.contextBegin << " - " << comment << endl;
 }
 
-void throwIfArgumentsUbruptlyEnds(vector<string>const&args,size_t&index,string const&argumentName){
-  if (index < args.size()) return;
-  stringstream ss;
-  ss << "Argument error:" << endl;
-  ss << "expected " << contextEnd
-     << " at the end of context: " << argumentName;
-  ss << " not end of arguments";
-  throw MatchError(ss.str());
+void ContextFormat::writeEnd(stringstream &ss, size_t indent) const {
+  writeIndentation(ss, indent);
+  ss << syntax.contextEnd << endl;
 }
 
-Format::MatchStatus ContextFormat::match(vector<string> const &args,
-                                         size_t &index) const {
-  size_t oldIndex = index;
+Format::MatchStatus ContextFormat::match(Tokens const &        args,
+                                         size_t &              index,
+                                         Diagnostics &diagnostics) const {
   if (index >= args.size()) return MATCH_FAILURE;
-  if (args.at(index) != argumentName) return MATCH_FAILURE;
-  ++index;
-  throwIfIndexIsOutOfRange(args,index,argumentName);
-  throwIfArgumentIsNotContextBegin(args,index,argumentName);
-  ++index;
-  auto unusedFormats = getUnusedFormats();
-  while (index < args.size() &&
-         args.at(index) != contextEnd) {
-    checkAndMatchOneUnusedFormat(unusedFormats,args,index);
-  }
-  throwIfArgumentsUbruptlyEnds(args,index,argumentName);
-  ++index;
+  if (args.at(index).text != argumentName) return MATCH_FAILURE;
+  IncrementalMatcher::matchContextOnce(*this, args, index, diagnostics);
   return MATCH_SUCCESS;
 }
+
+bool ContextFormat::isOfType(FormatTypeId id) const
+{
+  return id == getFormatTypeId<ContextFormat>() || ArgumentListFormat::isOfType(id);
+}
@@ -1,17 +1,23 @@
 #pragma once
 
 #include <ArgumentViewer/private/ArgumentListFormat.h>
-#include <ArgumentViewer/private/Globals.h>
 
 class ContextFormat : public ArgumentListFormat {
  public:
   string argumentName;
-  ContextFormat(string const &argument, string const &com);
+  ContextFormat(string const &                  argument,
+                string const &                  com,
+                argumentViewer::Syntax const &syntax);
+  argumentViewer::Syntax syntax;
 
   virtual string toStr(size_t indent,
                             size_t = 0,
                             size_t = 0,
                             size_t = 0) const override;
-  virtual MatchStatus match(vector<string> const &args,
-                            size_t &index) const override;
+  virtual MatchStatus match(Tokens const &        args,
+                            size_t &              index,
+                            Diagnostics &         diagnostics) const override;
+  virtual bool        isOfType(FormatTypeId id) const override;
+  void                writeBegin(stringstream &ss, size_t indent) const;
+  void                writeEnd(stringstream &ss, size_t indent) const;
 };
@@ -0,0 +1,82 @@
+#include <ArgumentViewer/private/ContextIndex.h>
+
+/**
+ * @brief Indexes arguments, contexts without their end are not indexed
+ *
+ * @param args arguments without unresolved includes
+ */
+void ContextIndex::build(Tokens const &args)
+{
+  nodes.clear();
+  nofArguments = args.size();
+  nodes.push_back({0, args.size(), {}, {}});
+  // node of every open context, nodes of contexts without name are not
+  // reachable, they only keep their arguments out of their parent
+  vector<size_t> stack = {root};
+  for (size_t i = 0; i < args.size(); ++i) {
+    auto const &token = args[i];
+    if (token.kind == Token::CONTEXT_END) {
+      if (stack.size() == 1) {
+        nodes[root].end = i;
+        break;
+      }
+      nodes[stack.back()].end = i;
+      stack.pop_back();
+      continue;
+    }
+    auto &positions = nodes[stack.back()].positions;
+    positions.emplace(token.text, i);
+    if (token.kind != Token::CONTEXT_BEGIN) continue;
+    size_t const child = nodes.size();
+    if (i > 0) {
+      auto const name = positions.find(args[i - 1].text);
+      if (name != positions.end() && name->second == i - 1)
+        nodes[stack.back()].children.emplace(name->first, child);
+    }
+    nodes.push_back({i + 1, missing, {}, {}});
+    stack.push_back(child);
+  }
+}
+
+void ContextIndex::clear()
+{
+  nodes.clear();
+  nofArguments = 0;
+}
+
+bool ContextIndex::empty() const { return nodes.empty(); }
+
+size_t ContextIndex::getPosition(size_t node, string const &argument) const
+{
+  if (node == missing) return nofArguments;
+  auto const &positions = nodes.at(node).positions;
+  auto const  it        = positions.find(argument);
+  if (it == positions.end()) return nofArguments;
+  return it->second;
+}
+
+/**
+ * @brief Returns node of context, it is missing if context is not in
+ * arguments or its end is missing
+ */
+size_t ContextIndex::getChild(size_t node, string const &name) const
+{
+  if (node == missing) return missing;
+  auto const &children = nodes.at(node).children;
+  auto const  it       = children.find(name);
+  if (it == children.end() || nodes.at(it->second).end == missing)
+    return missing;
+  return it->second;
+}
+
+size_t ContextIndex::getBegin(size_t node) const
+{
+  if (node == missing) return 0;
+  return nodes.at(node).begin;
+}
+
+size_t ContextIndex::getEnd(size_t node) const
+{
+  if (node == missing) return 0;
+  return nodes.at(node).end;
+}
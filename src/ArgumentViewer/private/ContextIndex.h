@@ -0,0 +1,42 @@
+#pragma once
+
+#include <ArgumentViewer/private/Token.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Positions of arguments in every context, it is built by one pass
+ * over arguments.
+ * Node root represents arguments outside of contexts. A context is indexed
+ * under the first occurrence of its name, as it is read by
+ * ArgumentViewer::getContext.
+ */
+class ContextIndex {
+ public:
+  static size_t const root    = 0;
+  // node of context that is not in arguments
+  static size_t const missing = static_cast<size_t>(-1);
+  void   build(Tokens const &args);
+  void   clear();
+  bool   empty() const;
+  // returns args.size() if argument is not in context
+  size_t getPosition(size_t node, string const &argument) const;
+  size_t getChild(size_t node, string const &name) const;
+  size_t getBegin(size_t node) const;
+  size_t getEnd(size_t node) const;
+
+ protected:
+  struct Node {
+    // arguments of context are in range [begin,end)
+    size_t                        begin;
+    size_t                        end;
+    // first position of every argument that is not nested deeper
+    unordered_map<string, size_t> positions;
+    unordered_map<string, size_t> children;
+  };
+  vector<Node> nodes;
+  size_t       nofArguments = 0;
+};
@@ -0,0 +1,253 @@
+#include <ArgumentViewer/private/ContextFormat.h>
+#include <ArgumentViewer/private/EffectiveConfiguration.h>
+#include <ArgumentViewer/private/Hash128.h>
+#include <ArgumentViewer/private/IsPresentFormat.h>
+#include <ArgumentViewer/private/StringVectorFormat.h>
+#include <ArgumentViewer/private/ValueFormat.h>
+
+namespace {
+// list of arguments whose formats are visited, nested contexts are visited
+// using explicit stack of them
+struct VisitedList {
+  ArgumentListFormat const *                         format;
+  map<string, IncrementalMatcher::MatchStep const *> steps;
+  map<string, shared_ptr<Format>>::const_iterator    next;
+};
+
+VisitedList visitList(ArgumentListFormat const &           format,
+                      IncrementalMatcher::ListMatch const *match)
+{
+  VisitedList result{&format, {}, format.formats.begin()};
+  if (match)
+    for (auto const &step : match->steps)
+      if (step.formatName != "") result.steps.emplace(step.formatName, &step);
+  return result;
+}
+}  // namespace
+
+void visitConfiguration(ArgumentListFormat const &           format,
+                        Tokens const &                       args,
+                        IncrementalMatcher::ListMatch const *match,
+                        ConfigurationVisitor &               visitor)
+{
+  vector<VisitedList> stack;
+  stack.push_back(visitList(format, match));
+  while (!stack.empty()) {
+    auto &list = stack.back();
+    if (list.next == list.format->formats.end()) {
+      stack.pop_back();
+      if (!stack.empty()) visitor.endContext();
+      continue;
+    }
+    auto const &x    = *list.next++;
+    auto const  it   = list.steps.find(x.first);
+    auto const  step = it == list.steps.end() ? nullptr : it->second;
+    if (auto const context = formatCast<ContextFormat>(x.second)) {
+      visitor.beginContext(x.first);
+      stack.push_back(visitList(*context, step ? step->body.get() : nullptr));
+      continue;
+    }
+    if (isTypeOf<IsPresentFormat>(x.second)) {
+      visitor.flag(x.first, step != nullptr);
+      continue;
+    }
+    auto const valueFormat = formatCast<ValueFormat>(x.second);
+    if (!valueFormat) continue;
+    size_t const begin = step ? step->begin : 0;
+    size_t const end   = step ? step->end : 0;
+    visitor.values(x.first, *valueFormat,
+                   valueFormat->getEffectiveValues(args, begin, end));
+  }
+}
+
+namespace {
+// values of string vector are enclosed in context delimiters
+bool isBracketed(ValueFormat const &format)
+{
+  return format.isOfType(getFormatTypeId<StringVectorFormat>());
+}
+
+class CanonicalWriter : public ConfigurationVisitor {
+ public:
+  virtual void flag(string const &name, bool present) override
+  {
+    data += 'f';
+    writeText(name);
+    data += present ? '1' : '0';
+  }
+  virtual void values(string const &        name,
+                      ValueFormat const &   format,
+                      vector<string> const &values) override
+  {
+    data += isBracketed(format) ? 's' : 'v';
+    writeText(name);
+    writeSize(values.size());
+    for (auto const &value : values) writeText(value);
+  }
+  virtual void beginContext(string const &name) override
+  {
+    data += 'c';
+    writeText(name);
+  }
+  virtual void endContext() override { data += 'e'; }
+  string       data;
+
+ private:
+  void writeSize(uint64_t size)
+  {
+    for (size_t i = 0; i < sizeof(size); ++i) data += char(size >> (8 * i));
+  }
+  void writeText(string const &text)
+  {
+    writeSize(text.size());
+    data += text;
+  }
+};
+}  // namespace
+
+argumentViewer::Fingerprint computeFingerprint(
+    ArgumentListFormat const &           format,
+    Tokens const &                       args,
+    IncrementalMatcher::ListMatch const *match)
+{
+  CanonicalWriter writer;
+  visitConfiguration(format, args, match, writer);
+  argumentViewer::Fingerprint result;
+  hash128(writer.data.data(), writer.data.size(), result.low, result.high);
+  return result;
+}
+
+namespace {
+class FileWriter : public ConfigurationVisitor {
+ public:
+  FileWriter(ostream &                     s,
+             Tokens const &                a,
+             argumentViewer::Syntax const &sx,
+             vector<string> &              u)
+      : stream(s), args(a), syntax(sx), unrepresentable(u)
+  {
+  }
+  virtual void flag(string const &name, bool present) override
+  {
+    if (!present) return;
+    writeIndentation();
+    stream << name << "\n";
+  }
+  virtual void values(string const &        name,
+                      ValueFormat const &   format,
+                      vector<string> const &values) override
+  {
+    if (values.size() == 1 && values.front() == "" &&
+        format.getEffectiveValues(args, 0, 0) == values)
+      return;
+    writeIndentation();
+    stream << name;
+    if (isBracketed(format)) stream << " " << syntax.contextBegin;
+    for (auto const &value : values) {
+      stream << " ";
+      writeValue(getPath(name), value);
+    }
+    if (isBracketed(format)) stream << " " << syntax.contextEnd;
+    stream << "\n";
+  }
+  virtual void beginContext(string const &name) override
+  {
+    writeIndentation();
+    stream << name << " " << syntax.contextBegin << "\n";
+    contexts.push_back(name);
+  }
+  virtual void endContext() override
+  {
+    contexts.pop_back();
+    writeIndentation();
+    stream << syntax.contextEnd << "\n";
+  }
+
+ private:
+  void writeIndentation()
+  {
+    for (size_t i = 0; i < contexts.size(); ++i) stream << "  ";
+  }
+  string getPath(string const &name) const
+  {
+    string result;
+    for (auto const &context : contexts) result += context + "/";
+    return result + name;
+  }
+  void writeValue(string const &path, string const &value)
+  {
+    bool const representable =
+        value != "" && value.find_first_of(" \t\n\r#") == string::npos;
+    Token const token(value, syntax);
+    if (!representable || token.kind == Token::ESCAPED_VALUE) {
+      unrepresentable.push_back(path);
+      return;
+    }
+    if (token.kind != Token::VALUE) stream << "\\";
+    stream << value;
+  }
+  ostream &                     stream;
+  Tokens const &                args;
+  argumentViewer::Syntax const &syntax;
+  vector<string> &              unrepresentable;
+  vector<string>                contexts;
+};
+
+class TokenWriter : public ConfigurationVisitor {
+ public:
+  TokenWriter(argumentViewer::Syntax const &s) : syntax(s) {}
+  virtual void flag(string const &name, bool present) override
+  {
+    if (present) addValue(name);
+  }
+  virtual void values(string const &        name,
+                      ValueFormat const &   format,
+                      vector<string> const &values) override
+  {
+    addValue(name);
+    if (isBracketed(format)) addDelimiter(syntax.contextBegin);
+    for (auto const &value : values) addValue(value);
+    if (isBracketed(format)) addDelimiter(syntax.contextEnd);
+  }
+  virtual void beginContext(string const &name) override
+  {
+    addValue(name);
+    addDelimiter(syntax.contextBegin);
+  }
+  virtual void endContext() override { addDelimiter(syntax.contextEnd); }
+  Tokens       tokens;
+
+ private:
+  void addValue(string const &value)
+  {
+    tokens.emplace_back(value, syntax);
+    tokens.back().kind = Token::VALUE;
+  }
+  void addDelimiter(char delimiter)
+  {
+    tokens.emplace_back(string(1, delimiter), syntax);
+  }
+  argumentViewer::Syntax const &syntax;
+};
+}  // namespace
+
+void writeConfigurationFile(ostream &                            stream,
+                            ArgumentListFormat const &           format,
+                            Tokens const &                       args,
+                            IncrementalMatcher::ListMatch const *match,
+                            argumentViewer::Syntax const &       syntax,
+                            vector<string> &                     unrepresentable)
+{
+  FileWriter writer(stream, args, syntax, unrepresentable);
+  visitConfiguration(format, args, match, writer);
+}
+
+Tokens getConfigurationTokens(ArgumentListFormat const &           format,
+                              Tokens const &                       args,
+                              IncrementalMatcher::ListMatch const *match,
+                              argumentViewer::Syntax const &       syntax)
+{
+  TokenWriter writer(syntax);
+  visitConfiguration(format, args, match, writer);
+  return writer.tokens;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <ArgumentViewer/Fingerprint.h>
+#include <ArgumentViewer/private/ArgumentListFormat.h>
+#include <ArgumentViewer/private/IncrementalMatcher.h>
+#include <ArgumentViewer/private/ValueFormat.h>
+#include <ostream>
+
+/**
+ * @brief Receives effective values of all registered arguments.
+ * Arguments come sorted by name, contexts are visited in place.
+ * Values are normalized and defaults are applied.
+ */
+class ConfigurationVisitor {
+ public:
+  virtual ~ConfigurationVisitor() {}
+  virtual void flag(string const &name, bool present) = 0;
+  virtual void values(string const &        name,
+                      ValueFormat const &   format,
+                      vector<string> const &values) = 0;
+  virtual void beginContext(string const &name) = 0;
+  virtual void endContext()                     = 0;
+};
+
+/**
+ * @brief Visits effective configuration using the result of one match.
+ * Every argument is interpreted as it was matched, no argument is searched.
+ *
+ * @param format format of arguments
+ * @param args arguments
+ * @param match result of the match of args, nullptr means no argument
+ * @param visitor visitor
+ */
+void visitConfiguration(ArgumentListFormat const &           format,
+                        Tokens const &                       args,
+                        IncrementalMatcher::ListMatch const *match,
+                        ConfigurationVisitor &               visitor);
+
+/**
+ * @brief Computes hash of canonical form of effective configuration.
+ * Every field of the canonical form is prefixed by its length so
+ * different configurations cannot have the same canonical form.
+ */
+argumentViewer::Fingerprint computeFingerprint(
+    ArgumentListFormat const &           format,
+    Tokens const &                       args,
+    IncrementalMatcher::ListMatch const *match);
+
+/**
+ * @brief Writes effective configuration as argument file.
+ * Values that cannot be written into argument file (empty, with white space
+ * or "#") are returned in unrepresentable, except empty values that are equal
+ * to defaults, they are omitted.
+ */
+void writeConfigurationFile(ostream &                            stream,
+                            ArgumentListFormat const &           format,
+                            Tokens const &                       args,
+                            IncrementalMatcher::ListMatch const *match,
+                            argumentViewer::Syntax const &       syntax,
+                            vector<string> &                     unrepresentable);
+
+/**
+ * @brief Converts effective configuration into arguments.
+ * Values are not escaped, their kind is always Token::VALUE.
+ */
+Tokens getConfigurationTokens(ArgumentListFormat const &           format,
+                              Tokens const &                       args,
+                              IncrementalMatcher::ListMatch const *match,
+                              argumentViewer::Syntax const &       syntax);
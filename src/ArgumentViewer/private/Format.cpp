@@ -2,6 +2,11 @@
 #include <ArgumentViewer/private/Format.h>
 #include <ArgumentViewer/private/Globals.h>
 
+bool Format::isOfType(FormatTypeId id) const
+{
+  return id == getFormatTypeId<Format>();
+}
+
 void Format::writeComment(stringstream &ss) const
 {
   if (comment != "") ss << commentSeparator << comment;
@@ -22,3 +27,76 @@ void writeIndentation(stringstream &ss, size_t indentation)
   writeSpaces(ss, indentation);
 }
 
+
+bool isContextBeginMissing(Tokens const &        args, size_t index)
+{
+  return index >= args.size() || args.at(index).kind != Token::CONTEXT_BEGIN;
+}
+
+void addDiagnostic(Diagnostics &                    diagnostics,
+                   argumentViewer::Diagnostic::Kind kind,
+                   size_t                           index,
+                   size_t                           argumentIndex,
+                   string const &                   type)
+{
+  argumentViewer::Diagnostic diagnostic;
+  diagnostic.kind          = kind;
+  diagnostic.index         = index;
+  diagnostic.argumentIndex = argumentIndex;
+  diagnostic.type          = type;
+  diagnostics.push_back(diagnostic);
+}
+
+void writeArgumentOrEnd(stringstream &        ss,
+                        Tokens const &        args,
+                        size_t                index)
+{
+  if (index < args.size())
+    ss << args.at(index).text;
+  else
+    ss << "end of arguments";
+}
+
+/**
+ * @brief Creates human readable message of diagnostic
+ *
+ * @param diagnostic diagnostic
+ * @param args arguments that were matched
+ * @param syntax delimiters of arguments
+ *
+ * @return message
+ */
+string getDiagnosticMessage(argumentViewer::Diagnostic const &diagnostic,
+                            Tokens const &                    args,
+                            argumentViewer::Syntax const &    syntax)
+{
+  using argumentViewer::Diagnostic;
+  stringstream ss;
+  auto const & argumentName = args.at(diagnostic.argumentIndex).text;
+  switch (diagnostic.kind) {
+    case Diagnostic::UNKNOWN_ARGUMENT:
+      ss << "Argument error:" << endl;
+      ss << "argument: " << argumentName << " at index: " << diagnostic.index
+         << " cannot be matched";
+      break;
+    case Diagnostic::MISSING_VALUE:
+    case Diagnostic::INCOMPATIBLE_VALUE:
+      ss << "Single value argument: " << argumentName
+         << " should be followed by value of type: " << diagnostic.type
+         << " not by: ";
+      writeArgumentOrEnd(ss, args, diagnostic.index);
+      break;
+    case Diagnostic::MISSING_CONTEXT_BEGIN:
+      ss << "Argument error:" << endl;
+      ss << "expected " << syntax.contextBegin << " after argument: " << argumentName
+         << " not: ";
+      writeArgumentOrEnd(ss, args, diagnostic.index);
+      break;
+    case Diagnostic::MISSING_CONTEXT_END:
+      ss << "Argument error:" << endl;
+      ss << "expected " << syntax.contextEnd << " at the end of context: "
+         << argumentName << " not end of arguments";
+      break;
+  }
+  return ss.str();
+}
@@ -1,11 +1,26 @@
 #pragma once
 
+#include <ArgumentViewer/Diagnostic.h>
+#include <ArgumentViewer/private/Token.h>
+#include <memory>
 #include <string>
 #include <vector>
 #include <sstream>
 
 using namespace std;
 
+typedef vector<argumentViewer::Diagnostic> Diagnostics;
+
+// identification of format class that does not need RTTI
+typedef void const *FormatTypeId;
+
+template <typename TYPE>
+FormatTypeId getFormatTypeId()
+{
+  static char const id = 0;
+  return &id;
+}
+
 class Format {
  public:
   string comment;
@@ -20,8 +35,10 @@ class Format {
                             size_t maxNameSize = 0,
                             size_t maxDefaultsSize = 0,
                             size_t maxTypeSize = 0) const = 0;
-  virtual MatchStatus match(vector<string> const &args,
-                            size_t &              index) const          = 0;
+  virtual MatchStatus match(Tokens const &        args,
+                            size_t &              index,
+                            Diagnostics &         diagnostics) const    = 0;
+  virtual bool        isOfType(FormatTypeId id) const;
  protected:
   void writeComment(stringstream&ss)const;
 };
@@ -29,3 +46,25 @@ class Format {
 void writeIndentation(stringstream&ss,size_t indentation);
 void writeSpaces(stringstream&ss,size_t nofSpaces);
 void writeAlignedString(stringstream &ss, string const &txt, size_t size);
+template <typename TO, typename FROM>
+shared_ptr<TO> formatCast(shared_ptr<FROM> const &value)
+{
+  if (!value || !value->isOfType(getFormatTypeId<TO>())) return nullptr;
+  return static_pointer_cast<TO>(value);
+}
+
+template <typename TO, typename FROM>
+bool isTypeOf(shared_ptr<FROM> const &value)
+{
+  return formatCast<TO>(value) != nullptr;
+}
+
+bool isContextBeginMissing(Tokens const &        args, size_t index);
+void addDiagnostic(Diagnostics &                    diagnostics,
+                   argumentViewer::Diagnostic::Kind kind,
+                   size_t                           index,
+                   size_t                           argumentIndex,
+                   string const &                   type = "");
+string getDiagnosticMessage(argumentViewer::Diagnostic const &diagnostic,
+                            Tokens const &                    args,
+                            argumentViewer::Syntax const &    syntax);
@@ -0,0 +1,60 @@
+#include <ArgumentViewer/private/CommonFunctions.h>
+#include <ArgumentViewer/private/ForwardedContextFormat.h>
+#include <ArgumentViewer/private/Globals.h>
+#include <sstream>
+
+using namespace argumentViewer;
+
+ForwardedContextFormat::ForwardedContextFormat(string const &name,
+                                               string const &com)
+    : Format(com), argumentName(name)
+{
+}
+
+string ForwardedContextFormat::toStr(size_t indent,
+                                     size_t maxNameSize,
+                                     size_t maxDefaultsSize,
+                                     size_t maxTypeSize) const
+{
+  stringstream ss;
+  writeIndentation(ss, indent);
+  writeAlignedString(ss, argumentName, maxNameSize);
+  writeSpaces(ss, defaultsSeparator.length() + maxDefaultsSize +
+                      typePreDecorator.length() + maxTypeSize +
+                      typePostDecorator.length());
+  writeComment(ss);
+  writeLineEnd(ss);
+  return ss.str();
+}
+
+Format::MatchStatus ForwardedContextFormat::match(Tokens const &args,
+                                                  size_t &      index,
+                                                  Diagnostics & diagnostics) const
+{
+  if (index >= args.size()) return MATCH_FAILURE;
+  size_t const argumentIndex = index;
+  if (args.at(index).text != argumentName) return MATCH_FAILURE;
+  ++index;
+  if (isContextBeginMissing(args, index)) {
+    addDiagnostic(diagnostics, Diagnostic::MISSING_CONTEXT_BEGIN, index,
+                  argumentIndex);
+    return MATCH_SUCCESS;
+  }
+  ++index;
+  size_t depth = 0;
+  while (index < args.size()) {
+    auto const kind = args.at(index++).kind;
+    if (kind == Token::CONTEXT_BEGIN) ++depth;
+    if (kind != Token::CONTEXT_END) continue;
+    if (depth == 0) return MATCH_SUCCESS;
+    --depth;
+  }
+  addDiagnostic(diagnostics, Diagnostic::MISSING_CONTEXT_END, index,
+                argumentIndex);
+  return MATCH_SUCCESS;
+}
+
+bool ForwardedContextFormat::isOfType(FormatTypeId id) const
+{
+  return id == getFormatTypeId<ForwardedContextFormat>() || Format::isOfType(id);
+}
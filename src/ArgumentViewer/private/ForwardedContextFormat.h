@@ -0,0 +1,22 @@
+#pragma once
+
+#include <ArgumentViewer/private/Format.h>
+
+/**
+ * @brief Context whose arguments belong to another program.
+ * Its arguments are skipped by matching, they are forwarded by
+ * ArgumentViewer::getContextArgv.
+ */
+class ForwardedContextFormat : public Format {
+ public:
+  ForwardedContextFormat(string const &name, string const &com);
+  virtual string      toStr(size_t indent,
+                            size_t maxNameSize,
+                            size_t maxDefaultsSize,
+                            size_t maxTypeSize) const override final;
+  virtual MatchStatus match(Tokens const &        args,
+                            size_t &              index,
+                            Diagnostics &         diagnostics) const override;
+  virtual bool        isOfType(FormatTypeId id) const override;
+  string              argumentName;
+};
@@ -1,8 +1,7 @@
 #include <ArgumentViewer/private/Globals.h>
 
-std::string const contextBegin          = "{"  ;
-std::string const contextEnd            = "}"  ;
-std::string const fileSymbol            = "<"  ;
+std::string const sweepSymbol           = "sweep";
+std::string const rangeSymbol           = "range";
 std::string const commentSeparator      = " - ";
 std::string const defaultsSeparator     = " = ";
 std::string const typePreDecorator      = " [" ;
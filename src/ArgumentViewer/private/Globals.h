@@ -2,9 +2,8 @@
 
 #include<string>
 
-extern std::string const contextBegin         ;
-extern std::string const contextEnd           ;
-extern std::string const fileSymbol           ;
+extern std::string const sweepSymbol          ;
+extern std::string const rangeSymbol          ;
 extern std::string const commentSeparator     ;
 extern std::string const defaultsSeparator    ;
 extern std::string const typePreDecorator     ;
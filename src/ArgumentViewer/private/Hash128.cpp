@@ -0,0 +1,79 @@
+#include <ArgumentViewer/private/Hash128.h>
+
+namespace {
+uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+uint64_t fmix(uint64_t k)
+{
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdull;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ull;
+  k ^= k >> 33;
+  return k;
+}
+
+uint64_t readBlock(uint8_t const *data, size_t size)
+{
+  uint64_t result = 0;
+  for (size_t i = 0; i < size; ++i) result |= uint64_t(data[i]) << (8 * i);
+  return result;
+}
+}  // namespace
+
+void hash128(void const *data, size_t size, uint64_t &low, uint64_t &high)
+{
+  uint64_t const c1    = 0x87c37b91114253d5ull;
+  uint64_t const c2    = 0x4cf5ad432745937full;
+  auto const     bytes = static_cast<uint8_t const *>(data);
+  uint64_t       h1    = 0;
+  uint64_t       h2    = 0;
+
+  size_t const nofBlocks = size / 16;
+  for (size_t i = 0; i < nofBlocks; ++i) {
+    uint64_t k1 = readBlock(bytes + i * 16, 8);
+    uint64_t k2 = readBlock(bytes + i * 16 + 8, 8);
+    k1 *= c1;
+    k1 = rotl(k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+    h1 = rotl(h1, 27);
+    h1 += h2;
+    h1 = h1 * 5 + 0x52dce729;
+    k2 *= c2;
+    k2 = rotl(k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+    h2 = rotl(h2, 31);
+    h2 += h1;
+    h2 = h2 * 5 + 0x38495ab5;
+  }
+
+  uint8_t const *tail     = bytes + nofBlocks * 16;
+  size_t const   tailSize = size & 15;
+  uint64_t       k1       = readBlock(tail, tailSize < 8 ? tailSize : 8);
+  uint64_t       k2 = tailSize > 8 ? readBlock(tail + 8, tailSize - 8) : 0;
+  if (tailSize > 8) {
+    k2 *= c2;
+    k2 = rotl(k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+  }
+  if (tailSize > 0) {
+    k1 *= c1;
+    k1 = rotl(k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+  }
+
+  h1 ^= size;
+  h2 ^= size;
+  h1 += h2;
+  h2 += h1;
+  h1 = fmix(h1);
+  h2 = fmix(h2);
+  h1 += h2;
+  h2 += h1;
+  low  = h1;
+  high = h2;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 128 bit non-cryptographic hash (MurmurHash3 x64 128).
+ * Result does not depend on endianness of the platform.
+ *
+ * @param data data
+ * @param size size of data in bytes
+ * @param low lower 64 bits of the hash
+ * @param high higher 64 bits of the hash
+ */
+void hash128(void const *data, size_t size, uint64_t &low, uint64_t &high);
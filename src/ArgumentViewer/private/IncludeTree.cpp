@@ -0,0 +1,25 @@
+#include <ArgumentViewer/private/IncludeTree.h>
+
+IncludeTree::IncludeTree() { nodes.push_back({"", root}); }
+
+bool IncludeTree::isLoadedBy(size_t node, string const &fileName) const
+{
+  while (node != root) {
+    if (nodes.at(node).fileName == fileName) return true;
+    node = nodes.at(node).parent;
+  }
+  return false;
+}
+
+size_t IncludeTree::getDepth(size_t node) const
+{
+  size_t depth = 0;
+  for (; node != root; node = nodes.at(node).parent) ++depth;
+  return depth;
+}
+
+size_t IncludeTree::addFile(size_t parent, string const &fileName)
+{
+  nodes.push_back({fileName, parent});
+  return nodes.size() - 1;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Records which file included which, so lazily loaded files can
+ * detect file loading loops.
+ * Node 0 represents arguments of the application.
+ */
+class IncludeTree {
+ public:
+  static size_t const root = 0;
+  IncludeTree();
+  size_t addFile(size_t parent, string const &fileName);
+  bool   isLoadedBy(size_t node, string const &fileName) const;
+  size_t getDepth(size_t node) const;
+
+ protected:
+  struct Node {
+    string fileName;
+    size_t parent;
+  };
+  vector<Node> nodes;
+};
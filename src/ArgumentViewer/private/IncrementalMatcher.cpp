@@ -0,0 +1,401 @@
+#include <ArgumentViewer/private/IncrementalMatcher.h>
+#include <ArgumentViewer/private/UsedFormats.h>
+
+using namespace argumentViewer;
+
+namespace {
+// explicit stacks of nested contexts are not reallocated up to this depth
+size_t const typicalDepth = 8;
+
+bool isEndOfList(Tokens const &args, size_t index, bool context)
+{
+  if (index >= args.size()) return true;
+  return context && args.at(index).kind == Token::CONTEXT_END;
+}
+}  // namespace
+
+/**
+ * @brief Releases bodies of nested contexts one by one,
+ * deep hierarchy does not overflow the call stack
+ */
+IncrementalMatcher::ListMatch::~ListMatch()
+{
+  vector<shared_ptr<ListMatch>> released;
+  auto const hasBodies = [](ListMatch const &list) {
+    for (auto const &step : list.steps)
+      if (step.body) return true;
+    return false;
+  };
+  auto const release = [&](ListMatch &list) {
+    for (auto &step : list.steps) {
+      if (step.body.use_count() != 1) continue;
+      // body without nested bodies is released directly
+      if (hasBodies(*step.body))
+        released.push_back(std::move(step.body));
+      else
+        step.body = nullptr;
+    }
+  };
+  release(*this);
+  while (!released.empty()) {
+    auto const body = std::move(released.back());
+    released.pop_back();
+    release(*body);
+  }
+}
+
+/**
+ * @brief Matches arguments of list from scratch, it is the only walk over
+ * arguments, ArgumentListFormat::match and ContextFormat::match use it too.
+ * Nested contexts are matched using explicit stack.
+ */
+shared_ptr<IncrementalMatcher::ListMatch> IncrementalMatcher::matchList(
+    ArgumentListFormat const &format,
+    Tokens const &            args,
+    size_t &                  index,
+    bool                      context,
+    vector<size_t> const &    layerEnds)
+{
+  struct Level {
+    ListMatch * list;
+    UsedFormats used;
+    bool        context;
+  };
+  auto result        = make_shared<ListMatch>();
+  result->nofFormats = format.formats.size();
+  vector<Level> stack;
+  stack.reserve(typicalDepth);
+  stack.push_back({result.get(), UsedFormats(format, layerEnds), context});
+  while (!stack.empty()) {
+    auto &level = stack.back();
+    if (isEndOfList(args, index, level.context)) {
+      level.list->end = index;
+      stack.pop_back();
+      // the list is body of context, it is closed by step of its parent
+      if (!stack.empty()) closeContext(args, index, stack.back().list->steps.back());
+      continue;
+    }
+    auto const subFormat = level.used.use(args.at(index).text, index);
+    if (!subFormat) {
+      level.list->steps.push_back(matchUnknown(args, index));
+      continue;
+    }
+    auto const contextFormat = formatCast<ContextFormat>(subFormat);
+    if (!contextFormat) {
+      level.list->steps.push_back(matchFormat(subFormat, args, index));
+      continue;
+    }
+    MatchStep step;
+    step.begin      = index;
+    step.formatName = args.at(index).text;
+    if (!openContext(*contextFormat, args, index, step)) {
+      level.list->steps.push_back(std::move(step));
+      continue;
+    }
+    auto const body = step.body.get();
+    level.list->steps.push_back(std::move(step));
+    stack.push_back({body, UsedFormats(*contextFormat), true});
+  }
+  return result;
+}
+
+/**
+ * @brief Replays old match of list, unknown arguments are matched by new
+ * formats.
+ * Nested contexts are replayed using explicit stack, a context whose
+ * replay fails is matched from scratch.
+ *
+ * @return new match or nullptr if list has to be matched from scratch
+ */
+shared_ptr<IncrementalMatcher::ListMatch> IncrementalMatcher::rematchList(
+    ArgumentListFormat const &format,
+    Tokens const &            args,
+    size_t                    index,
+    bool                      context,
+    ListMatch const &         old,
+    vector<size_t> const &    layerEnds)
+{
+  struct Level {
+    ArgumentListFormat const *format;
+    ListMatch const *         old;
+    bool                      context;
+    shared_ptr<ListMatch>     result;
+    size_t                    index;
+    size_t                    stepIndex;
+    UsedFormats               used;
+  };
+  auto const openLevel = [&](ArgumentListFormat const &f, ListMatch const &o,
+                             size_t i, bool c, vector<size_t> const &ends) {
+    Level level{&f, &o, c, make_shared<ListMatch>(), i, 0, {}};
+    level.result->nofFormats = f.formats.size();
+    // used formats are needed only to match unknown arguments by new formats
+    if (level.result->nofFormats == o.nofFormats) return level;
+    level.used = UsedFormats(f, ends);
+    for (auto const &step : o.steps)
+      if (step.formatName != "") level.used.use(step.formatName, step.begin);
+    return level;
+  };
+  // layers are used only outside of contexts
+  vector<size_t> const noLayers;
+  vector<Level>        stack;
+  stack.reserve(typicalDepth);
+  stack.push_back(openLevel(format, old, index, context, layerEnds));
+  // new body of context that was replayed, nullptr if it has to be matched
+  shared_ptr<ListMatch> body;
+  bool                  bodyReplayed = false;
+  while (true) {
+    auto &level  = stack.back();
+    bool  failed = false;
+    if (bodyReplayed) {
+      bodyReplayed = false;
+      // the last step of level is copy of old step, it has old body
+      auto &step = level.result->steps.back();
+      if (!body) {
+        size_t bodyIndex = step.begin + 2;
+        body             = matchList(
+            *formatCast<ContextFormat>(level.format->formats.at(step.formatName)),
+            args, bodyIndex, true);
+      }
+      failed    = body->end != step.body->end;
+      step.body = std::move(body);
+      level.index = step.end;
+      ++level.stepIndex;
+    }
+    bool const hasNewFormats = level.result->nofFormats != level.old->nofFormats;
+    ContextFormat const *bodyFormat = nullptr;
+    while (!failed && !bodyFormat && level.stepIndex < level.old->steps.size()) {
+      auto const &step = level.old->steps[level.stepIndex];
+      if (step.begin != level.index) {
+        failed = true;
+        break;
+      }
+      if (step.formatName != "") {
+        level.result->steps.push_back(step);
+        auto const contextFormat =
+            formatCast<ContextFormat>(level.format->formats.at(step.formatName));
+        if (contextFormat && step.body) {
+          bodyFormat = contextFormat.get();
+          break;
+        }
+        level.index = step.end;
+        ++level.stepIndex;
+        continue;
+      }
+      auto const subFormat =
+          hasNewFormats ? level.used.use(args.at(level.index).text, level.index)
+                        : nullptr;
+      if (!subFormat) {
+        level.result->steps.push_back(step);
+        level.index = step.end;
+        ++level.stepIndex;
+        continue;
+      }
+      level.result->steps.push_back(matchFormat(subFormat, args, level.index));
+      while (level.stepIndex < level.old->steps.size() &&
+             level.old->steps[level.stepIndex].begin < level.index) {
+        if (level.old->steps[level.stepIndex].formatName != "") {
+          failed = true;
+          break;
+        }
+        ++level.stepIndex;
+      }
+    }
+    if (bodyFormat) {
+      auto const &step = level.result->steps.back();
+      stack.push_back(
+          openLevel(*bodyFormat, *step.body, step.begin + 2, true, noLayers));
+      continue;
+    }
+    if (!failed && (level.index != level.old->end ||
+                    !isEndOfList(args, level.index, level.context)))
+      failed = true;
+    if (!failed) level.result->end = level.index;
+    body = failed ? nullptr : std::move(level.result);
+    stack.pop_back();
+    if (stack.empty()) return body;
+    bodyReplayed = true;
+  }
+}
+
+IncrementalMatcher::MatchStep IncrementalMatcher::matchFormat(
+    shared_ptr<Format> const &format, Tokens const &args, size_t &index)
+{
+  MatchStep step;
+  step.begin      = index;
+  step.formatName = args.at(index).text;
+  auto const contextFormat = formatCast<ContextFormat>(format);
+  if (contextFormat)
+    matchContext(*contextFormat, args, index, step);
+  else
+    format->match(args, index, step.diagnostics);
+  step.end = index;
+  return step;
+}
+
+IncrementalMatcher::MatchStep IncrementalMatcher::matchUnknown(Tokens const &args,
+                                                        size_t &      index)
+{
+  MatchStep step;
+  step.begin = index;
+  addDiagnostic(step.diagnostics, Diagnostic::UNKNOWN_ARGUMENT, index, index);
+  skipUnknownArgument(args, index);
+  step.end = index;
+  return step;
+}
+
+/**
+ * @brief Skips name of context and context begin
+ *
+ * @return false if context begin is missing, step is finished then,
+ * otherwise step has empty body
+ */
+bool IncrementalMatcher::openContext(ContextFormat const &format,
+                                     Tokens const &       args,
+                                     size_t &             index,
+                                     MatchStep &          step)
+{
+  size_t const argumentIndex = index++;
+  if (isContextBeginMissing(args, index)) {
+    addDiagnostic(step.diagnostics, Diagnostic::MISSING_CONTEXT_BEGIN, index,
+                  argumentIndex);
+    step.end = index;
+    return false;
+  }
+  ++index;
+  step.body             = make_shared<ListMatch>();
+  step.body->nofFormats = format.formats.size();
+  return true;
+}
+
+/**
+ * @brief Skips context end after body of context, it finishes step
+ */
+void IncrementalMatcher::closeContext(Tokens const &args,
+                                      size_t &      index,
+                                      MatchStep &   step)
+{
+  if (index >= args.size())
+    addDiagnostic(step.diagnostics, Diagnostic::MISSING_CONTEXT_END, index,
+                  step.begin);
+  else
+    ++index;
+  step.end = index;
+}
+
+void IncrementalMatcher::matchContext(ContextFormat const &format,
+                                              Tokens const &       args,
+                                              size_t &             index,
+                                              MatchStep &          step)
+{
+  if (!openContext(format, args, index, step)) return;
+  step.body = matchList(format, args, index, true);
+  closeContext(args, index, step);
+}
+
+/**
+ * @brief Collects diagnostics of steps in the order they were found,
+ * diagnostics of context body precede diagnostics of context
+ */
+void IncrementalMatcher::gather(ListMatch const &list,
+                                    Diagnostics &    diagnostics)
+{
+  struct Level {
+    ListMatch const *list;
+    size_t           step;
+  };
+  vector<Level> stack;
+  stack.reserve(typicalDepth);
+  stack.push_back({&list, 0});
+  bool bodyGathered = false;
+  while (!stack.empty()) {
+    auto &level = stack.back();
+    if (level.step == level.list->steps.size()) {
+      stack.pop_back();
+      bodyGathered = true;
+      continue;
+    }
+    auto const &step = level.list->steps[level.step];
+    if (step.body && !bodyGathered) {
+      stack.push_back({step.body.get(), 0});
+      continue;
+    }
+    diagnostics.insert(diagnostics.end(), step.diagnostics.begin(),
+                       step.diagnostics.end());
+    ++level.step;
+    bodyGathered = false;
+  }
+}
+
+/**
+ * @brief Matches arguments of list from scratch without remembering result
+ *
+ * @param format format of list
+ * @param args arguments
+ * @param index index of the first argument, it is moved after list
+ * @param diagnostics found problems are appended
+ * @param layerEnds ends of layers of arguments outside of contexts
+ */
+void IncrementalMatcher::matchOnce(ArgumentListFormat const &format,
+                                   Tokens const &            args,
+                                   size_t &                  index,
+                                   Diagnostics &             diagnostics,
+                                   vector<size_t> const &    layerEnds)
+{
+  gather(*matchList(format, args, index, false, layerEnds), diagnostics);
+}
+
+/**
+ * @brief Matches name of context and its body from scratch without
+ * remembering result
+ *
+ * @param format format of context, its name is at index
+ * @param args arguments
+ * @param index index of name of context, it is moved after context
+ * @param diagnostics found problems are appended
+ */
+void IncrementalMatcher::matchContextOnce(ContextFormat const &format,
+                                          Tokens const &       args,
+                                          size_t &             index,
+                                          Diagnostics &        diagnostics)
+{
+  MatchStep step;
+  step.begin = index;
+  matchContext(format, args, index, step);
+  ListMatch list;
+  list.steps.push_back(std::move(step));
+  gather(list, diagnostics);
+}
+
+/**
+ * @brief Matches all arguments by format, it reuses result of the last match
+ *
+ * @param format format of all arguments
+ * @param args arguments, they have to be the same as in the last match,
+ * otherwise reset() has to be called
+ * @param layerEnds ends of layers of arguments outside of contexts
+ *
+ * @return all problems found in arguments
+ */
+Diagnostics IncrementalMatcher::match(ArgumentListFormat const &format,
+                                      Tokens const &            args,
+                                      vector<size_t> const &    layerEnds)
+{
+  if (root) root = rematchList(format, args, 0, false, *root, layerEnds);
+  if (!root) {
+    size_t index = 0;
+    root         = matchList(format, args, index, false, layerEnds);
+  }
+  Diagnostics diagnostics;
+  gather(*root, diagnostics);
+  return diagnostics;
+}
+
+/**
+ * @brief Forgets the last match, it has to be called when arguments change
+ */
+void IncrementalMatcher::reset() { root = nullptr; }
+
+IncrementalMatcher::ListMatch const *IncrementalMatcher::getLastMatch() const
+{
+  return root.get();
+}
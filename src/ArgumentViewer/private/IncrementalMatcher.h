@@ -0,0 +1,82 @@
+#pragma once
+
+#include <ArgumentViewer/private/ArgumentListFormat.h>
+#include <ArgumentViewer/private/ContextFormat.h>
+#include <memory>
+
+/**
+ * @brief Matcher that remembers result of the last match.
+ * Formats can only be added between matches, so tokens consumed by
+ * a format stay consumed. Next match replays remembered steps and it tries
+ * to match only unknown arguments by newly added formats.
+ * If a new format consumes tokens that were consumed by other format,
+ * the list of arguments is matched again from scratch.
+ * ArgumentListFormat::match uses the same walk through matchOnce.
+ * Arguments outside of contexts can be split into layers, an argument can
+ * be repeated in a lower layer.
+ */
+class IncrementalMatcher {
+ public:
+  Diagnostics match(ArgumentListFormat const &format,
+                    Tokens const &            args,
+                    vector<size_t> const &    layerEnds = {});
+  void        reset();
+  static void matchOnce(ArgumentListFormat const &format,
+                        Tokens const &            args,
+                        size_t &                  index,
+                        Diagnostics &             diagnostics,
+                        vector<size_t> const &    layerEnds = {});
+  static void matchContextOnce(ContextFormat const &format,
+                               Tokens const &       args,
+                               size_t &             index,
+                               Diagnostics &        diagnostics);
+
+  struct ListMatch;
+  struct MatchStep {
+    size_t begin;
+    size_t end;
+    // empty for unknown argument
+    string      formatName;
+    Diagnostics diagnostics;
+    // arguments of context, nullptr if context begin is missing
+    shared_ptr<ListMatch> body;
+  };
+  struct ListMatch {
+    ~ListMatch();
+    vector<MatchStep> steps;
+    size_t            nofFormats = 0;
+    size_t            end        = 0;
+  };
+  // result of the last match, nullptr before the first one
+  ListMatch const *getLastMatch() const;
+
+ protected:
+  static shared_ptr<ListMatch> matchList(ArgumentListFormat const &format,
+                                         Tokens const &            args,
+                                         size_t &                  index,
+                                         bool                      context,
+                                         vector<size_t> const &    layerEnds = {});
+  static shared_ptr<ListMatch> rematchList(ArgumentListFormat const &format,
+                                           Tokens const &            args,
+                                           size_t                    index,
+                                           bool                      context,
+                                           ListMatch const &         old,
+                                           vector<size_t> const &    layerEnds = {});
+  static MatchStep matchFormat(shared_ptr<Format> const &format,
+                               Tokens const &            args,
+                               size_t &                  index);
+  static MatchStep matchUnknown(Tokens const &args, size_t &index);
+  static bool      openContext(ContextFormat const &format,
+                               Tokens const &       args,
+                               size_t &             index,
+                               MatchStep &          step);
+  static void      closeContext(Tokens const &args,
+                                size_t &      index,
+                                MatchStep &   step);
+  static void      matchContext(ContextFormat const &format,
+                                Tokens const &       args,
+                                size_t &             index,
+                                MatchStep &          step);
+  static void      gather(ListMatch const &list, Diagnostics &diagnostics);
+  shared_ptr<ListMatch> root;
+};
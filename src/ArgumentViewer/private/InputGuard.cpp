@@ -0,0 +1,144 @@
+#include <ArgumentViewer/private/InputGuard.h>
+
+InputGuard::InputGuard(argumentViewer::Limits const &l) : limits(l) {}
+
+/**
+ * @brief Counts tokens of command line or of one file
+ *
+ * @param tokens tokens that are read
+ * @param message description of exceeded limit
+ *
+ * @return false if number of tokens or length of a token exceeds limits
+ */
+bool InputGuard::addTokens(Tokens const &tokens, string &message)
+{
+  if (exceeded) return false;
+  if (tokens.size() > limits.maxTokens - nofTokens) {
+    return fail(message, "number of arguments exceeds limit: " +
+                             to_string(limits.maxTokens));
+  }
+  nofTokens += tokens.size();
+  if (limits.maxTokenLength == argumentViewer::Limits::unlimited) return true;
+  for (auto const &token : tokens) {
+    if (token.text.size() <= limits.maxTokenLength) continue;
+    return fail(message, "argument: " + token.text.substr(0, 32) +
+                             "... is longer than limit: " +
+                             to_string(limits.maxTokenLength));
+  }
+  return true;
+}
+
+/**
+ * @brief Counts included file before it is read
+ *
+ * @param fileName name of file
+ * @param includeDepth depth of file, file included from command line has 1
+ * @param message description of exceeded limit
+ *
+ * @return false if the file cannot be read within limits
+ */
+bool InputGuard::addInclude(string const &fileName,
+                            size_t        includeDepth,
+                            string &      message)
+{
+  if (exceeded) return false;
+  if (includeDepth > limits.maxIncludeDepth) {
+    return fail(message, "file: " + fileName +
+                             " exceeds limit of include depth: " +
+                             to_string(limits.maxIncludeDepth));
+  }
+  if (nofIncludes >= limits.maxIncludes) {
+    return fail(message, "file: " + fileName +
+                             " exceeds limit of included files: " +
+                             to_string(limits.maxIncludes));
+  }
+  ++nofIncludes;
+  return true;
+}
+
+/**
+ * @brief Counts bytes read from included file
+ *
+ * @param fileName name of file
+ * @param nofReadBytes number of bytes read from file, the file is read at most
+ * one byte over getRemainingBytes()
+ * @param message description of exceeded limit
+ *
+ * @return false if the file exceeds limit of read bytes
+ */
+bool InputGuard::addBytes(string const &fileName,
+                          size_t        nofReadBytes,
+                          string &      message)
+{
+  if (exceeded) return false;
+  if (nofReadBytes > getRemainingBytes()) {
+    return fail(message, "file: " + fileName +
+                             " exceeds limit of read bytes: " +
+                             to_string(limits.maxBytes));
+  }
+  nofBytes += nofReadBytes;
+  return true;
+}
+
+/**
+ * @brief Returns number of bytes that can still be read from files
+ */
+size_t InputGuard::getRemainingBytes() const
+{
+  return limits.maxBytes - nofBytes;
+}
+
+/**
+ * @brief Checks depth of contexts
+ *
+ * @param tokens tokens that are checked
+ * @param depth depth of contexts that contain tokens
+ * @param message description of exceeded limit
+ *
+ * @return false if tokens are nested deeper than limit
+ */
+bool InputGuard::checkNesting(Tokens const &tokens,
+                              size_t        depth,
+                              string &      message)
+{
+  if (exceeded) return false;
+  if (!limitsNesting()) return true;
+  for (auto const &token : tokens) {
+    if (token.kind == Token::CONTEXT_END && depth > 0) --depth;
+    if (token.kind != Token::CONTEXT_BEGIN) continue;
+    if (++depth <= limits.maxNestingDepth) continue;
+    return fail(message, "contexts are nested deeper than limit: " +
+                             to_string(limits.maxNestingDepth));
+  }
+  return true;
+}
+
+argumentViewer::Limits const &InputGuard::getLimits() const { return limits; }
+
+bool InputGuard::fail(string &message, string const &reason)
+{
+  exceeded = true;
+  message  = reason;
+  return false;
+}
+
+bool InputGuard::limitsNesting() const
+{
+  return limits.maxNestingDepth != argumentViewer::Limits::unlimited;
+}
+
+/**
+ * @brief Returns number of contexts that are open before token end
+ * if depth contexts are open before token begin
+ */
+size_t InputGuard::getNestingDepth(Tokens const &tokens,
+                                   size_t        begin,
+                                   size_t        end,
+                                   size_t        depth)
+{
+  for (size_t i = begin; i < end && i < tokens.size(); ++i) {
+    if (tokens[i].kind == Token::CONTEXT_BEGIN) ++depth;
+    if (tokens[i].kind == Token::CONTEXT_END && depth > 0) --depth;
+  }
+  return depth;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <ArgumentViewer/Limits.h>
+#include <ArgumentViewer/private/Token.h>
+#include <string>
+
+using namespace std;
+
+/**
+ * @brief Counts input read by ArgumentViewer and its context viewers and
+ * checks it against limits.
+ * Every check returns false and describes exceeded limit in message.
+ */
+class InputGuard {
+ public:
+  InputGuard(argumentViewer::Limits const &limits = {});
+  bool   addTokens(Tokens const &tokens, string &message);
+  bool   addInclude(string const &fileName,
+                    size_t        includeDepth,
+                    string &      message);
+  bool   addBytes(string const &fileName, size_t nofReadBytes, string &message);
+  size_t getRemainingBytes() const;
+  bool   checkNesting(Tokens const &tokens,
+                      size_t        depth,
+                      string &      message);
+  bool   limitsNesting() const;
+  argumentViewer::Limits const &getLimits() const;
+  static size_t getNestingDepth(Tokens const &tokens,
+                                size_t        begin,
+                                size_t        end,
+                                size_t        depth);
+
+ protected:
+  argumentViewer::Limits limits;
+  size_t                 nofTokens   = 0;
+  size_t                 nofIncludes = 0;
+  size_t                 nofBytes    = 0;
+  // after the first exceeded limit, nothing more is read
+  bool                   exceeded    = false;
+  bool                   fail(string &message, string const &reason);
+};
@@ -41,11 +41,17 @@ string IsPresentFormat::toStr(size_t indent,
   return ss.str();
 }
 
-Format::MatchStatus IsPresentFormat::match(vector<string> const &args,
-                                           size_t &              index) const
+Format::MatchStatus IsPresentFormat::match(Tokens const &        args,
+                                           size_t &              index,
+                                           Diagnostics &) const
 {
   if (index >= args.size()) return MATCH_FAILURE;
-  if (args.at(index) != argumentName) return MATCH_FAILURE;
+  if (args.at(index).text != argumentName) return MATCH_FAILURE;
   index++;
   return MATCH_SUCCESS;
 }
+
+bool IsPresentFormat::isOfType(FormatTypeId id) const
+{
+  return id == getFormatTypeId<IsPresentFormat>() || Format::isOfType(id);
+}
@@ -9,7 +9,9 @@ class IsPresentFormat : public Format {
                             size_t maxNameSize,
                             size_t maxDefaultsSize,
                             size_t maxTypeSize) const override final;
-  virtual MatchStatus match(vector<string> const &args,
-                            size_t &              index) const override;
+  virtual MatchStatus match(Tokens const &        args,
+                            size_t &              index,
+                            Diagnostics &         diagnostics) const override;
+  virtual bool        isOfType(FormatTypeId id) const override;
   string              argumentName;
 };
@@ -0,0 +1,451 @@
+#include <ArgumentViewer/private/JsonReader.h>
+
+using namespace argumentViewer;
+
+/**
+ * @brief Returns true if argument file is read as JSON document
+ */
+bool isJsonFile(string const &fileName)
+{
+  string const extension = ".json";
+  return fileName.length() > extension.length() &&
+         fileName.compare(fileName.length() - extension.length(),
+                          extension.length(), extension) == 0;
+}
+
+namespace {
+/**
+ * @brief Reads JSON document in one pass and writes arguments directly,
+ * no tree of the document is built.
+ * Objects are read by an explicit stack, so depth of document is limited
+ * only by its size.
+ */
+class JsonReader {
+ public:
+  JsonReader(Tokens &                       tokens,
+             string const &                 content,
+             argumentViewer::Syntax const &syntax,
+             PositionList *                 positions);
+  bool   read();
+  string error;
+
+ protected:
+  enum ArrayKind {
+    // no element that decides kind is read yet
+    UNDECIDED,
+    // numbers and booleans, array is vector value
+    VALUES,
+    // strings, array is list of strings enclosed in context
+    STRINGS,
+    // objects or arrays, array is context with elements named by index
+    INDEXED,
+  };
+  enum ElementKind {
+    STRING,
+    NUMBER,
+    TRUE_VALUE,
+    FALSE_VALUE,
+    NULL_VALUE,
+    CONTAINER,
+  };
+  struct Level {
+    bool      array;
+    ArrayKind kind;
+    // arrays are named when their kind is known
+    string    name;
+    size_t    nameOffset;
+    size_t    offset;
+    // top level object is not enclosed in context
+    bool      context;
+    size_t    nofElements;
+    // array is element of array, its values would follow index like values
+    bool      inArray;
+  };
+  bool fail(string const &message);
+  bool atEnd() const;
+  void skipSpace();
+  bool expect(char c);
+  bool readString(string &text);
+  bool readHex(unsigned &code);
+  bool readNumber(string &text);
+  bool readLiteral(string const &literal);
+  bool readScalar(ElementKind &kind, string &text);
+  bool readElement(vector<Level> &levels);
+  bool addToArray(Level &level, ElementKind kind);
+  void closeLevel(vector<Level> &levels);
+  void addPosition(size_t offset);
+  void emit(string const &text, size_t offset);
+  void emitDelimiter(char delimiter, size_t offset);
+  Tokens &                       tokens;
+  string const &                 content;
+  argumentViewer::Syntax const &syntax;
+  PositionList *                 positions;
+  size_t                         position  = 0;
+  // lines are counted incrementally, tokens are written in increasing order
+  size_t                         scanned   = 0;
+  size_t                         line      = 1;
+  size_t                         lineStart = 0;
+};
+
+JsonReader::JsonReader(Tokens &                       t,
+                       string const &                 c,
+                       argumentViewer::Syntax const &s,
+                       PositionList *                 p)
+    : tokens(t), content(c), syntax(s), positions(p)
+{
+}
+
+bool JsonReader::fail(string const &message)
+{
+  size_t errorLine  = 1;
+  size_t errorStart = 0;
+  for (size_t i = 0; i < position && i < content.length(); ++i)
+    if (content[i] == '\n') {
+      ++errorLine;
+      errorStart = i + 1;
+    }
+  error = message + " at line " + to_string(errorLine) + " column " +
+          to_string(position - errorStart + 1);
+  return false;
+}
+
+bool JsonReader::atEnd() const { return position >= content.length(); }
+
+void JsonReader::skipSpace()
+{
+  while (!atEnd()) {
+    char const c = content[position];
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r') return;
+    ++position;
+  }
+}
+
+bool JsonReader::expect(char c)
+{
+  if (atEnd() || content[position] != c) return false;
+  ++position;
+  return true;
+}
+
+bool JsonReader::readHex(unsigned &code)
+{
+  code = 0;
+  for (size_t i = 0; i < 4; ++i, ++position) {
+    if (atEnd()) return fail("unfinished escape sequence");
+    char const c = content[position];
+    code <<= 4;
+    if (c >= '0' && c <= '9')
+      code |= static_cast<unsigned>(c - '0');
+    else if (c >= 'a' && c <= 'f')
+      code |= static_cast<unsigned>(c - 'a' + 10);
+    else if (c >= 'A' && c <= 'F')
+      code |= static_cast<unsigned>(c - 'A' + 10);
+    else
+      return fail("invalid escape sequence");
+  }
+  return true;
+}
+
+void appendUtf8(string &text, unsigned code)
+{
+  if (code < 0x80) {
+    text += static_cast<char>(code);
+    return;
+  }
+  if (code < 0x800) {
+    text += static_cast<char>(0xc0 | (code >> 6));
+    text += static_cast<char>(0x80 | (code & 0x3f));
+    return;
+  }
+  if (code < 0x10000) {
+    text += static_cast<char>(0xe0 | (code >> 12));
+    text += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+    text += static_cast<char>(0x80 | (code & 0x3f));
+    return;
+  }
+  text += static_cast<char>(0xf0 | (code >> 18));
+  text += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+  text += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+  text += static_cast<char>(0x80 | (code & 0x3f));
+}
+
+bool JsonReader::readString(string &text)
+{
+  if (!expect('"')) return fail("expected string");
+  text.clear();
+  while (true) {
+    if (atEnd()) return fail("unfinished string");
+    char const c = content[position++];
+    if (c == '"') return true;
+    if (static_cast<unsigned char>(c) < 0x20) {
+      --position;
+      return fail("control character in string");
+    }
+    if (c != '\\') {
+      text += c;
+      continue;
+    }
+    if (atEnd()) return fail("unfinished escape sequence");
+    char const e = content[position++];
+    switch (e) {
+      case '"':
+      case '\\':
+      case '/': text += e; break;
+      case 'b': text += '\b'; break;
+      case 'f': text += '\f'; break;
+      case 'n': text += '\n'; break;
+      case 'r': text += '\r'; break;
+      case 't': text += '\t'; break;
+      case 'u': {
+        unsigned code;
+        if (!readHex(code)) return false;
+        if (code >= 0xdc00 && code < 0xe000)
+          return fail("unpaired surrogate");
+        if (code >= 0xd800 && code < 0xdc00) {
+          unsigned low;
+          if (!expect('\\') || !expect('u') || !readHex(low) || low < 0xdc00 ||
+              low >= 0xe000)
+            return error != "" ? false : fail("unpaired surrogate");
+          code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+        }
+        appendUtf8(text, code);
+        break;
+      }
+      default: --position; return fail("invalid escape sequence");
+    }
+  }
+}
+
+bool JsonReader::readNumber(string &text)
+{
+  size_t const begin   = position;
+  auto const   isDigit = [&] {
+    return !atEnd() && content[position] >= '0' && content[position] <= '9';
+  };
+  auto const readDigits = [&] {
+    if (!isDigit()) return false;
+    while (isDigit()) ++position;
+    return true;
+  };
+  expect('-');
+  if (!expect('0') && !readDigits()) return fail("invalid number");
+  if (expect('.') && !readDigits()) return fail("invalid number");
+  if (expect('e') || expect('E')) {
+    if (!expect('+')) expect('-');
+    if (!readDigits()) return fail("invalid number");
+  }
+  text = content.substr(begin, position - begin);
+  return true;
+}
+
+bool JsonReader::readLiteral(string const &literal)
+{
+  if (content.compare(position, literal.length(), literal) != 0)
+    return fail("unexpected character");
+  position += literal.length();
+  return true;
+}
+
+bool JsonReader::readScalar(ElementKind &kind, string &text)
+{
+  char const c = content[position];
+  if (c == '"') {
+    kind = STRING;
+    return readString(text);
+  }
+  if (c == '-' || (c >= '0' && c <= '9')) {
+    kind = NUMBER;
+    return readNumber(text);
+  }
+  if (c == 't') {
+    kind = TRUE_VALUE;
+    return readLiteral("true");
+  }
+  if (c == 'f') {
+    kind = FALSE_VALUE;
+    return readLiteral("false");
+  }
+  kind = NULL_VALUE;
+  return readLiteral("null");
+}
+
+void JsonReader::addPosition(size_t offset)
+{
+  if (!positions) return;
+  for (; scanned < offset; ++scanned)
+    if (content[scanned] == '\n') {
+      ++line;
+      lineStart = scanned + 1;
+    }
+  positions->add(line, offset - lineStart + 1);
+}
+
+/**
+ * @brief Writes argument, value that looks like a delimiter is escaped
+ */
+void JsonReader::emit(string const &text, size_t offset)
+{
+  bool const isDelimiter =
+      text.length() == 1 &&
+      (text[0] == syntax.contextBegin || text[0] == syntax.contextEnd ||
+       text[0] == syntax.fileSymbol);
+  if (isDelimiter)
+    tokens.emplace_back("\\" + text, syntax);
+  else
+    tokens.emplace_back(text, syntax);
+  addPosition(offset);
+}
+
+void JsonReader::emitDelimiter(char delimiter, size_t offset)
+{
+  tokens.emplace_back(string(1, delimiter), syntax);
+  addPosition(offset);
+}
+
+/**
+ * @brief Decides kind of array by its first element that is not null and
+ * writes name of array.
+ * Strings cannot be mixed with numbers or booleans, nulls are skipped.
+ *
+ * @return false if element does not fit into array
+ */
+bool JsonReader::addToArray(Level &level, ElementKind kind)
+{
+  if (level.kind == UNDECIDED) {
+    if (kind == NULL_VALUE) return true;
+    level.kind = kind == CONTAINER ? INDEXED : kind == STRING ? STRINGS : VALUES;
+    if (level.kind == VALUES && level.inArray)
+      return fail("array of numbers or booleans is element of array");
+    emit(level.name, level.nameOffset);
+    if (level.kind != VALUES)
+      emitDelimiter(syntax.contextBegin, level.offset);
+    return true;
+  }
+  if (kind == CONTAINER && level.kind != INDEXED)
+    return fail("array of values contains object or array");
+  if (kind == STRING && level.kind == VALUES)
+    return fail("array of numbers or booleans contains string");
+  bool const isValue = kind == NUMBER || kind == TRUE_VALUE || kind == FALSE_VALUE;
+  if (isValue && level.kind == STRINGS)
+    return fail("array of strings contains number or boolean");
+  return true;
+}
+
+bool JsonReader::readElement(vector<Level> &levels)
+{
+  auto & level = levels.back();
+  string name;
+  size_t const nameOffset = position;
+  if (level.array)
+    name = to_string(level.nofElements);
+  else {
+    if (content[position] != '"') return fail("expected name of member");
+    if (!readString(name)) return false;
+    skipSpace();
+    if (!expect(':')) return fail("expected :");
+    skipSpace();
+  }
+  ++level.nofElements;
+  if (atEnd()) return fail("unexpected end of document");
+  size_t const offset = position;
+  char const   c      = content[position];
+  if (c == '{' || c == '[') {
+    if (level.array && !addToArray(level, CONTAINER)) return false;
+    ++position;
+    if (c == '{') {
+      emit(name, nameOffset);
+      emitDelimiter(syntax.contextBegin, offset);
+    }
+    bool const inArray = level.array;
+    levels.push_back(
+        {c == '[', UNDECIDED, name, nameOffset, offset, true, 0, inArray});
+    return true;
+  }
+  ElementKind kind;
+  string      text;
+  if (!readScalar(kind, text)) return false;
+  if (level.array && !addToArray(level, kind)) return false;
+  bool const named = !level.array || level.kind == INDEXED;
+  if (named) {
+    // true is read as flag, false and null as missing argument
+    if (kind == FALSE_VALUE || kind == NULL_VALUE) return true;
+    emit(name, nameOffset);
+    if (kind != TRUE_VALUE) emit(text, offset);
+    return true;
+  }
+  if (kind == NULL_VALUE) return true;
+  if (kind == TRUE_VALUE) text = "1";
+  if (kind == FALSE_VALUE) text = "0";
+  emit(text, offset);
+  return true;
+}
+
+void JsonReader::closeLevel(vector<Level> &levels)
+{
+  auto const &level = levels.back();
+  bool const  isContext =
+      level.array ? level.kind == STRINGS || level.kind == INDEXED : level.context;
+  if (isContext) emitDelimiter(syntax.contextEnd, position);
+  ++position;
+  levels.pop_back();
+}
+
+bool JsonReader::read()
+{
+  vector<Level> levels;
+  skipSpace();
+  if (!expect('{')) return fail("document is not an object");
+  levels.push_back({false, UNDECIDED, "", 0, 0, false, 0, false});
+  while (!levels.empty()) {
+    skipSpace();
+    if (atEnd()) return fail("unexpected end of document");
+    auto const &level = levels.back();
+    if (content[position] == (level.array ? ']' : '}')) {
+      closeLevel(levels);
+      continue;
+    }
+    if (level.nofElements > 0) {
+      if (!expect(',')) return fail("expected , or end of object or array");
+      skipSpace();
+      if (atEnd()) return fail("unexpected end of document");
+    }
+    if (!readElement(levels)) return false;
+  }
+  skipSpace();
+  if (!atEnd()) return fail("unexpected content after document");
+  return true;
+}
+}  // namespace
+
+/**
+ * @brief Reads JSON document as arguments.
+ * Members of the top level object are arguments. Objects are contexts.
+ * Arrays of numbers and booleans are vector values, arrays of strings are
+ * lists of strings in context, arrays that mix strings with numbers or
+ * booleans are not valid and arrays of objects or arrays are contexts
+ * with elements named by their indices. Arrays of numbers or booleans
+ * cannot be elements of arrays, their values could not be told apart from
+ * indices. Member that is true is a flag,
+ * members that are false or null are missing.
+ *
+ * @param tokens arguments are appended to tokens
+ * @param fileContent JSON document
+ * @param syntax delimiters of arguments
+ * @param positions positions of arguments, it can be nullptr
+ * @param error description of the first syntax error
+ *
+ * @return false if document is not valid, tokens are not changed then
+ */
+bool splitJsonToArguments(Tokens &                       tokens,
+                          string const &                 fileContent,
+                          argumentViewer::Syntax const &syntax,
+                          PositionList *                 positions,
+                          string &                       error)
+{
+  size_t const nofTokens = tokens.size();
+  JsonReader   reader(tokens, fileContent, syntax, positions);
+  if (reader.read()) return true;
+  tokens.resize(nofTokens);
+  error = reader.error;
+  return false;
+}
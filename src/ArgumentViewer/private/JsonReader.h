@@ -0,0 +1,15 @@
+#pragma once
+
+#include <ArgumentViewer/private/Provenance.h>
+#include <ArgumentViewer/private/Token.h>
+#include <string>
+
+using namespace std;
+
+bool isJsonFile(string const &fileName);
+
+bool splitJsonToArguments(Tokens &                       tokens,
+                          string const &                 fileContent,
+                          argumentViewer::Syntax const &syntax,
+                          PositionList *                 positions,
+                          string &                       error);
@@ -0,0 +1,140 @@
+#include <ArgumentViewer/private/Layers.h>
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <stdlib.h>
+#elif defined(__APPLE__)
+#include <crt_externs.h>
+#else
+extern char **environ;
+#endif
+
+using namespace argumentViewer;
+
+void LayerEnds::add(Layers::Layer layer, size_t end)
+{
+  layers.push_back(layer);
+  ends.push_back(end);
+}
+
+bool LayerEnds::empty() const { return ends.empty(); }
+
+bool hasLayers(Layers const &layers)
+{
+  return !layers.files.empty() || layers.environmentPrefix != "";
+}
+
+/**
+ * @brief Default mapping of environment variables, LIGHT_INTENSITY is read
+ * as --light-intensity
+ */
+string getEnvironmentArgumentName(string const &variable)
+{
+  string result = "--";
+  for (auto const c : variable)
+    result += c == '_' ? '-' : static_cast<char>(tolower(c));
+  return result;
+}
+
+namespace {
+char **getEnvironment()
+{
+#if defined(_WIN32)
+  return _environ;
+#elif defined(__APPLE__)
+  // environ is not visible to shared libraries
+  return *_NSGetEnviron();
+#else
+  return environ;
+#endif
+}
+
+void appendEnvironment(Tokens &         args,
+                       ProvenanceMap &  provenance,
+                       Layers const &   layers,
+                       Syntax const &   syntax)
+{
+  auto const &prefix = layers.environmentPrefix;
+  // order of variables is not defined, they are sorted to get the same
+  // arguments from the same environment
+  vector<pair<string, string>> variables;
+  for (auto variable = getEnvironment(); *variable; ++variable) {
+    string const text      = *variable;
+    auto const   separator = text.find('=');
+    if (separator == string::npos || text.compare(0, prefix.size(), prefix) != 0)
+      continue;
+    variables.emplace_back(
+        text.substr(prefix.size(), separator - prefix.size()),
+        text.substr(separator + 1));
+  }
+  sort(variables.begin(), variables.end());
+  for (auto const &variable : variables) {
+    auto const name = layers.environmentRule
+                          ? layers.environmentRule(variable.first)
+                          : getEnvironmentArgumentName(variable.first);
+    if (name == "") continue;
+    auto source  = make_shared<TokenSource>();
+    source->name = prefix + variable.first;
+    size_t const begin = args.size();
+    args.emplace_back(name, syntax);
+    source->positions.add(0, 0);
+    stringstream ss(variable.second);
+    string       value;
+    while (ss >> value) {
+      args.emplace_back(value, syntax);
+      source->positions.add(0, args.size() - begin - 1);
+    }
+    provenance.append(ProvenanceMap(source, args.size() - begin));
+  }
+}
+}  // namespace
+
+/**
+ * @brief Appends arguments of environment and includes of files after
+ * command line arguments
+ *
+ * @param args command line arguments
+ * @param provenance provenance of command line arguments
+ * @param ends ends of layers of args
+ * @param layers layers from settings
+ * @param syntax syntax of arguments
+ */
+void appendLayers(Tokens &          args,
+                  ProvenanceMap &   provenance,
+                  LayerEnds &       ends,
+                  Layers const &    layers,
+                  Syntax const &    syntax)
+{
+  ends.add(Layers::COMMAND_LINE, args.size());
+  if (layers.environmentPrefix != "") {
+    appendEnvironment(args, provenance, layers, syntax);
+    ends.add(Layers::ENVIRONMENT, args.size());
+  }
+  for (auto const &file : layers.files) {
+    args.emplace_back(string(1, syntax.fileSymbol), syntax);
+    args.emplace_back(file, syntax);
+    provenance.append(ProvenanceMap(nullptr, 2));
+    ends.add(Layers::FILE, args.size());
+  }
+}
+
+Layers::Layer getLayer(LayerEnds const &ends, size_t index)
+{
+  if (ends.empty()) return Layers::COMMAND_LINE;
+  auto const it = upper_bound(ends.ends.begin(), ends.ends.end(), index);
+  if (it == ends.ends.end()) return Layers::DEFAULT;
+  return ends.layers[it - ends.ends.begin()];
+}
+
+/**
+ * @brief Returns true if argument at index is in the same layer as argument
+ * at position, position <= index
+ */
+bool isInLayerOf(LayerEnds const &ends, size_t index, size_t position)
+{
+  if (ends.empty()) return true;
+  auto const end = upper_bound(ends.ends.begin(), ends.ends.end(), position);
+  return end == ends.ends.end() || index < *end;
+}
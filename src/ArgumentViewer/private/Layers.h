@@ -0,0 +1,28 @@
+#pragma once
+
+#include <ArgumentViewer/Layers.h>
+#include <ArgumentViewer/private/Provenance.h>
+#include <ArgumentViewer/private/Token.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// layer layers[i] of arguments ends at index ends[i] of arguments,
+// ends are passed to matcher as they are
+struct LayerEnds {
+  vector<argumentViewer::Layers::Layer> layers;
+  vector<size_t>                        ends;
+  void add(argumentViewer::Layers::Layer layer, size_t end);
+  bool empty() const;
+};
+
+bool hasLayers(argumentViewer::Layers const &layers);
+string getEnvironmentArgumentName(string const &variable);
+void   appendLayers(Tokens &                       args,
+                    ProvenanceMap &                provenance,
+                    LayerEnds &                    ends,
+                    argumentViewer::Layers const &layers,
+                    argumentViewer::Syntax const &syntax);
+argumentViewer::Layers::Layer getLayer(LayerEnds const &ends, size_t index);
+bool isInLayerOf(LayerEnds const &ends, size_t index, size_t position);
@@ -5,12 +5,17 @@
 string LineSplitter::get() const { return ss.str(); }
 
 void LineSplitter::addString(string const &text) {
-  auto const lineLength = ss.str().length() - lineStart + 1;
+  auto const lineLength = getLength() - lineStart + 1;
   auto const wouldOverflow = lineLength + text.length() >= maxDefaultsLineLength;
   if (wouldOverflow) {
     writeLineEnd(ss);
-    lineStart = ss.str().length();
+    lineStart = getLength();
     if (text == " ") return;
   }
   ss << text;
 }
+
+// tellp does not copy the content like ss.str()
+size_t LineSplitter::getLength() {
+  return static_cast<size_t>(ss.tellp());
+}
@@ -11,6 +11,7 @@ class LineSplitter {
   void   addString(string const &text);
 
  protected:
+  size_t       getLength();
   size_t       lineStart = 0;
   stringstream ss;
 };
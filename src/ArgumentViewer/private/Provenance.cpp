@@ -0,0 +1,118 @@
+#include <ArgumentViewer/private/Provenance.h>
+#include <algorithm>
+
+namespace {
+void writeVarint(vector<uint8_t> &data, size_t value)
+{
+  while (value >= 0x80) {
+    data.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  data.push_back(static_cast<uint8_t>(value));
+}
+
+size_t readVarint(vector<uint8_t> const &data, size_t &offset)
+{
+  size_t result = 0;
+  size_t shift  = 0;
+  while (data[offset] & 0x80) {
+    result |= size_t(data[offset++] & 0x7f) << shift;
+    shift += 7;
+  }
+  return result | (size_t(data[offset++]) << shift);
+}
+}  // namespace
+
+/**
+ * @brief Reserves memory for n positions that are mostly on one line
+ */
+void PositionList::reserve(size_t n)
+{
+  data.reserve(2 * n);
+  checkpoints.reserve(n / blockSize + 1);
+}
+
+void PositionList::add(size_t line, size_t column)
+{
+  if (nofPositions % blockSize == 0)
+    checkpoints.push_back({data.size(), line, column});
+  else {
+    writeVarint(data, line - lastLine);
+    writeVarint(data, line == lastLine ? column - lastColumn : column);
+  }
+  lastLine   = line;
+  lastColumn = column;
+  ++nofPositions;
+}
+
+size_t PositionList::size() const { return nofPositions; }
+
+void PositionList::get(size_t index, size_t &line, size_t &column) const
+{
+  auto const &checkpoint = checkpoints.at(index / blockSize);
+  size_t      offset     = checkpoint.offset;
+  line                   = checkpoint.line;
+  column                 = checkpoint.column;
+  for (size_t i = 0; i < index % blockSize; ++i) {
+    auto const lineDelta  = readVarint(data, offset);
+    auto const columnCode = readVarint(data, offset);
+    line += lineDelta;
+    column = lineDelta == 0 ? column + columnCode : columnCode;
+  }
+}
+
+ProvenanceMap::ProvenanceMap(shared_ptr<TokenSource const> const &source,
+                             size_t                               n)
+{
+  if (n == 0) return;
+  runs.push_back({0, source, 0});
+  nofTokens = n;
+}
+
+size_t ProvenanceMap::size() const { return nofTokens; }
+
+size_t ProvenanceMap::findRun(size_t index) const
+{
+  auto const it = upper_bound(
+      runs.begin(), runs.end(), index,
+      [](size_t i, Run const &run) { return i < run.begin; });
+  return static_cast<size_t>(it - runs.begin()) - 1;
+}
+
+/**
+ * @brief Appends provenance of tokens [begin,end) of other map
+ */
+void ProvenanceMap::append(ProvenanceMap const &other, size_t begin, size_t end)
+{
+  if (begin >= end) return;
+  for (size_t r = other.findRun(begin); r < other.runs.size(); ++r) {
+    auto const &run      = other.runs[r];
+    auto const  runEnd   = r + 1 < other.runs.size() ? other.runs[r + 1].begin
+                                                     : other.nofTokens;
+    auto const  from     = max(begin, run.begin);
+    auto const  to       = min(end, runEnd);
+    auto const  first    = run.first + from - run.begin;
+    bool const  continues = !runs.empty() && runs.back().source == run.source &&
+                           runs.back().first + nofTokens - runs.back().begin ==
+                               first;
+    if (!continues) runs.push_back({nofTokens, run.source, first});
+    nofTokens += to - from;
+    if (to == end) break;
+  }
+}
+
+void ProvenanceMap::append(ProvenanceMap const &other)
+{
+  append(other, 0, other.size());
+}
+
+bool ProvenanceMap::get(size_t              index,
+                        TokenSource const *&source,
+                        size_t &            sourceIndex) const
+{
+  if (index >= nofTokens) return false;
+  auto const &run = runs[findRun(index)];
+  source          = run.source.get();
+  sourceIndex     = run.first + index - run.begin;
+  return true;
+}
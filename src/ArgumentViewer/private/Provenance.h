@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Lines and columns of tokens of one source.
+ * Positions are delta encoded into bytes, a token on the same line as its
+ * predecessor stores only distance of columns. Every block of tokens starts
+ * by absolute position, so random access decodes only part of one block.
+ */
+class PositionList {
+ public:
+  void   reserve(size_t n);
+  void   add(size_t line, size_t column);
+  size_t size() const;
+  void   get(size_t index, size_t &line, size_t &column) const;
+
+ protected:
+  static size_t const blockSize = 64;
+  struct Checkpoint {
+    size_t offset;
+    size_t line;
+    size_t column;
+  };
+  vector<uint8_t>    data;
+  vector<Checkpoint> checkpoints;
+  size_t             nofPositions = 0;
+  size_t             lastLine     = 0;
+  size_t             lastColumn   = 0;
+};
+
+/**
+ * @brief Command line or argument file that tokens come from.
+ */
+struct TokenSource {
+  // empty for command line
+  string       name;
+  PositionList positions;
+};
+
+/**
+ * @brief Maps tokens of arguments to tokens of their sources.
+ * Tokens that come from one source in a row are stored as one run,
+ * so there are only a few runs per included file.
+ */
+class ProvenanceMap {
+ public:
+  ProvenanceMap() = default;
+  ProvenanceMap(shared_ptr<TokenSource const> const &source, size_t nofTokens);
+  size_t size() const;
+  void   append(ProvenanceMap const &other, size_t begin, size_t end);
+  void   append(ProvenanceMap const &other);
+  // returns false if index is out of range
+  bool   get(size_t              index,
+             TokenSource const *&source,
+             size_t &            sourceIndex) const;
+
+ protected:
+  struct Run {
+    // index of the first token of run
+    size_t                        begin;
+    shared_ptr<TokenSource const> source;
+    // index of the first token of run in its source
+    size_t                        first;
+  };
+  size_t findRun(size_t index) const;
+  vector<Run> runs;
+  size_t      nofTokens = 0;
+};
@@ -0,0 +1,192 @@
+#include <ArgumentViewer/private/ContextFormat.h>
+#include <ArgumentViewer/private/ForwardedContextFormat.h>
+#include <ArgumentViewer/private/IsPresentFormat.h>
+#include <ArgumentViewer/private/PushMatcherImpl.h>
+#include <ArgumentViewer/private/StringVectorFormat.h>
+
+void PushMatcherImpl::reset()
+{
+  Frame frame;
+  frame.kind   = Frame::LIST;
+  frame.format = root;
+  frame.used   = UsedFormats(*formatCast<ArgumentListFormat>(root));
+  stack.assign(1, frame);
+  lastStatus = PushState::ACCEPTED;
+}
+
+void PushMatcherImpl::openFormat(shared_ptr<Format> const &format,
+                                 string const &            name)
+{
+  Frame frame;
+  frame.name   = name;
+  frame.format = format;
+  if (isTypeOf<IsPresentFormat>(format)) return;
+  if (isTypeOf<ContextFormat>(format) || isTypeOf<StringVectorFormat>(format) ||
+      isTypeOf<ForwardedContextFormat>(format))
+    frame.kind = Frame::CONTEXT_BEGIN;
+  else if (formatCast<ValueFormat>(format)->hasMultipleValues())
+    frame.kind = Frame::VALUES;
+  else
+    frame.kind = Frame::VALUE;
+  stack.push_back(frame);
+}
+
+/**
+ * @brief Matches token by arguments of the innermost LIST,
+ * formats are chosen by UsedFormats like in ArgumentListFormat::match
+ *
+ * @return true if token was consumed
+ */
+bool PushMatcherImpl::pushToList(Token const &token, PushState::Status &status)
+{
+  auto &frame = stack.back();
+  if (token.kind == Token::CONTEXT_END && stack.size() > 1) {
+    stack.pop_back();
+    return true;
+  }
+  auto const format = frame.used.use(token.text);
+  if (!format) {
+    status = PushState::UNKNOWN_ARGUMENT;
+    Frame unknown;
+    unknown.kind = Frame::UNKNOWN_CONTEXT_BEGIN;
+    stack.push_back(unknown);
+    return true;
+  }
+  openFormat(format, token.text);
+  return true;
+}
+
+/**
+ * @brief Matches one token
+ *
+ * @param token token
+ *
+ * @return status of token
+ */
+PushState::Status PushMatcherImpl::push(Token const &token)
+{
+  auto status = PushState::ACCEPTED;
+  while (true) {
+    auto &frame = stack.back();
+    switch (frame.kind) {
+      case Frame::LIST:
+        pushToList(token, status);
+        return lastStatus = status;
+      case Frame::VALUE:
+        if (!formatCast<ValueFormat>(frame.format)->isValue(token))
+          status = PushState::INCOMPATIBLE_VALUE;
+        stack.pop_back();
+        return lastStatus = status;
+      case Frame::VALUES:
+        if (formatCast<ValueFormat>(frame.format)->isValue(token))
+          return lastStatus = status;
+        stack.pop_back();
+        break;
+      case Frame::CONTEXT_BEGIN:
+        if (token.kind == Token::CONTEXT_BEGIN) {
+          if (isTypeOf<ContextFormat>(frame.format)) {
+            frame.kind = Frame::LIST;
+            frame.used =
+                UsedFormats(*formatCast<ArgumentListFormat>(frame.format));
+          } else if (isTypeOf<ForwardedContextFormat>(frame.format))
+            frame.kind = Frame::FORWARDED_CONTEXT;
+          else
+            frame.kind = Frame::STRINGS;
+          return lastStatus = status;
+        }
+        status = PushState::MISSING_CONTEXT_BEGIN;
+        stack.pop_back();
+        break;
+      case Frame::STRINGS:
+        if (token.kind == Token::CONTEXT_END) stack.pop_back();
+        return lastStatus = status;
+      case Frame::UNKNOWN_CONTEXT_BEGIN:
+        if (token.kind == Token::CONTEXT_BEGIN) {
+          frame.kind = Frame::UNKNOWN_CONTEXT;
+          return lastStatus = PushState::UNKNOWN_ARGUMENT;
+        }
+        stack.pop_back();
+        break;
+      case Frame::UNKNOWN_CONTEXT:
+        if (token.kind == Token::CONTEXT_BEGIN) ++frame.depth;
+        if (token.kind == Token::CONTEXT_END) {
+          if (frame.depth == 0)
+            stack.pop_back();
+          else
+            --frame.depth;
+        }
+        return lastStatus = PushState::UNKNOWN_ARGUMENT;
+      case Frame::FORWARDED_CONTEXT:
+        if (token.kind == Token::CONTEXT_BEGIN) ++frame.depth;
+        if (token.kind == Token::CONTEXT_END) {
+          if (frame.depth == 0)
+            stack.pop_back();
+          else
+            --frame.depth;
+        }
+        return lastStatus = status;
+    }
+  }
+}
+
+void addListArguments(PushState &                    state,
+                      PushMatcherImpl::Frame const &frame,
+                      Syntax const &                 syntax,
+                      bool                           isContext)
+{
+  auto const alf = formatCast<ArgumentListFormat>(frame.format);
+  for (auto const &x : alf->formats)
+    if (!frame.used.isUsed(x.first)) state.nextArguments.push_back(x.first);
+  if (isContext) state.nextArguments.push_back(string(1, syntax.contextEnd));
+}
+
+/**
+ * @brief Returns state after the last token
+ *
+ * @return open contexts, expected value and arguments that can follow
+ */
+PushState PushMatcherImpl::getState() const
+{
+  PushState state;
+  state.status = lastStatus;
+  for (size_t i = 1; i < stack.size(); ++i)
+    if (stack[i].kind == Frame::LIST) state.contexts.push_back(stack[i].name);
+
+  size_t listIndex = stack.size() - 1;
+  while (stack[listIndex].kind != Frame::LIST) --listIndex;
+  auto const &list      = stack[listIndex];
+  bool const  isContext = listIndex > 0;
+  auto const &top       = stack.back();
+  switch (top.kind) {
+    case Frame::LIST:
+      addListArguments(state, list, syntax, isContext);
+      break;
+    case Frame::VALUE:
+      state.expectedType  = formatCast<ValueFormat>(top.format)->getType();
+      state.valueRequired = true;
+      break;
+    case Frame::VALUES:
+      state.expectedType = formatCast<ValueFormat>(top.format)->getType();
+      addListArguments(state, list, syntax, isContext);
+      break;
+    case Frame::CONTEXT_BEGIN:
+      state.nextArguments.push_back(string(1, syntax.contextBegin));
+      break;
+    case Frame::STRINGS:
+      state.expectedType = "string";
+      state.nextArguments.push_back(string(1, syntax.contextEnd));
+      break;
+    case Frame::UNKNOWN_CONTEXT_BEGIN:
+      addListArguments(state, list, syntax, isContext);
+      state.nextArguments.push_back(string(1, syntax.contextBegin));
+      break;
+    case Frame::UNKNOWN_CONTEXT:
+    case Frame::FORWARDED_CONTEXT:
+      state.nextArguments.push_back(string(1, syntax.contextEnd));
+      break;
+  }
+  state.complete = !isContext && (top.kind == Frame::LIST ||
+                                  top.kind == Frame::VALUES ||
+                                  top.kind == Frame::UNKNOWN_CONTEXT_BEGIN);
+  return state;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <ArgumentViewer/PushMatcher.h>
+#include <ArgumentViewer/Syntax.h>
+#include <ArgumentViewer/private/ArgumentListFormat.h>
+#include <ArgumentViewer/private/UsedFormats.h>
+
+using namespace argumentViewer;
+
+class argumentViewer::PushMatcherImpl {
+ public:
+  // explicit stack of open contexts and pending values
+  struct Frame {
+    enum Kind {
+      // arguments of context or of all arguments
+      LIST,
+      // one value has to follow
+      VALUE,
+      // values can follow
+      VALUES,
+      // context begin has to follow
+      CONTEXT_BEGIN,
+      // strings of string vector until context end
+      STRINGS,
+      // context begin of unknown argument can follow
+      UNKNOWN_CONTEXT_BEGIN,
+      // context of unknown argument until its context end
+      UNKNOWN_CONTEXT,
+      // forwarded context until its context end
+      FORWARDED_CONTEXT,
+    };
+    Kind               kind;
+    string             name;
+    shared_ptr<Format> format;
+    // formats of LIST that were already matched
+    UsedFormats used;
+    // depth of nested contexts in UNKNOWN_CONTEXT or FORWARDED_CONTEXT
+    size_t depth = 0;
+  };
+  shared_ptr<Format> root;
+  Syntax             syntax;
+  vector<Frame>      stack;
+  PushState::Status  lastStatus = PushState::ACCEPTED;
+  void               reset();
+  PushState::Status  push(Token const &token);
+  PushState          getState() const;
+
+ protected:
+  bool pushToList(Token const &token, PushState::Status &status);
+  void openFormat(shared_ptr<Format> const &format, string const &name);
+};
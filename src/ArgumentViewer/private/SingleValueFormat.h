@@ -1,27 +1,38 @@
 #pragma once
 
-#include <ArgumentViewer/Exception.h>
 #include <ArgumentViewer/private/CommonFunctions.h>
 #include <ArgumentViewer/private/ValueFormat.h>
+#include <ArgumentViewer/private/ValueParser.h>
 
 using namespace argumentViewer;
 
 template <typename TYPE>
 class SingleValueFormat : public ValueFormat {
  public:
-  SingleValueFormat(string const &argument, TYPE const &def, string const &com);
+  SingleValueFormat(string const &            argument,
+                    TYPE const &              def,
+                    string const &            com,
+                    ValueParser<TYPE> const &p = ValueParser<TYPE>());
   virtual string      getDefaults() const override;
   virtual string      getType() const override;
-  virtual MatchStatus match(vector<string> const &args,
-                            size_t &              index) const override;
+  virtual MatchStatus match(Tokens const &        args,
+                            size_t &              index,
+                            Diagnostics &         diagnostics) const override;
+  virtual bool        isOfType(FormatTypeId id) const override;
+  virtual bool        isValue(Token const &token) const override;
+  virtual vector<string> getEffectiveValues(Tokens const &args,
+                                            size_t        begin,
+                                            size_t        end) const override;
   TYPE                defaults;
+  ValueParser<TYPE>   parser;
 };
 
 template <typename TYPE>
-SingleValueFormat<TYPE>::SingleValueFormat(string const &argument,
-                                           TYPE const &  def,
-                                           string const &com)
-    : ValueFormat(argument, com), defaults(def)
+SingleValueFormat<TYPE>::SingleValueFormat(string const &           argument,
+                                           TYPE const &             def,
+                                           string const &           com,
+                                           ValueParser<TYPE> const &p)
+    : ValueFormat(argument, com), defaults(def), parser(p)
 {
 }
 
@@ -29,57 +40,59 @@ template <typename TYPE>
 string SingleValueFormat<TYPE>::getDefaults() const
 {
   if (is_same<TYPE, string>::value) {
-    auto x = txtUtils::valueToString(defaults);
+    auto x = parser.toStr(defaults);
     if(x=="\"\""||x=="")return "\"\"";
     return chopQuotes(x);
   }
-  return txtUtils::valueToString(defaults);
+  return parser.toStr(defaults);
 }
 
 template <typename TYPE>
 string SingleValueFormat<TYPE>::getType() const
 {
-  return typeName<TYPE>();
+  return parser.getType();
 }
 
 template <typename TYPE>
-void throwIfArgumentIsNotFollowedByValueButArgumentsEnds(
-    vector<string> const &args,
-    size_t &              index,
-    string const &        argumentName)
+Format::MatchStatus SingleValueFormat<TYPE>::match(Tokens const &        args,
+                                                   size_t &index,
+                                                   Diagnostics &diagnostics) const
 {
-  if (index < args.size()) return;
-  stringstream ss;
-  ss << "Single value argument: " << argumentName
-     << " should be followed by value of type: " << typeName<TYPE>()
-     << " not by end of arguments";
-  throw ex::MatchError(ss.str());
+  size_t const argumentIndex = index;
+  if (index >= args.size()) return MATCH_FAILURE;
+  if (args.at(index).text != argumentName) return MATCH_FAILURE;
+  ++index;
+  if (index >= args.size()) {
+    addDiagnostic(diagnostics, Diagnostic::MISSING_VALUE, index, argumentIndex,
+                  getType());
+    return MATCH_SUCCESS;
+  }
+  if (!parser.isValue(args.at(index)))
+    addDiagnostic(diagnostics, Diagnostic::INCOMPATIBLE_VALUE, index,
+                  argumentIndex, getType());
+  ++index;
+  return MATCH_SUCCESS;
 }
 
 template <typename TYPE>
-void throwIfArgumentIsNotFollowedByCompatibleValue(vector<string> const &args,
-                                                  size_t &              index,
-                                                  string const &argumentName)
+bool SingleValueFormat<TYPE>::isOfType(FormatTypeId id) const
 {
-  if (isValueConvertibleTo<TYPE>(args.at(index))) return;
-  stringstream ss;
-  ss << "Single value argument: " << argumentName
-     << " should be followed by value of type: " << typeName<TYPE>()
-     << " not by: " << args.at(index);
-  throw ex::MatchError(ss.str());
+  return id == getFormatTypeId<SingleValueFormat<TYPE>>() ||
+         ValueFormat::isOfType(id);
 }
 
 template <typename TYPE>
-Format::MatchStatus SingleValueFormat<TYPE>::match(vector<string> const &args,
-                                                   size_t &index) const
+bool SingleValueFormat<TYPE>::isValue(Token const &token) const
 {
-  size_t oldIndex = index;
-  if (index >= args.size()) return MATCH_FAILURE;
-  if (args.at(index) != argumentName) return MATCH_FAILURE;
-  ++index;
-  throwIfArgumentIsNotFollowedByValueButArgumentsEnds<TYPE>(args, index,
-                                                            argumentName);
-  throwIfArgumentIsNotFollowedByCompatibleValue<TYPE>(args, index, argumentName);
-  ++index;
-  return MATCH_SUCCESS;
+  return parser.isValue(token);
+}
+
+template <typename TYPE>
+vector<string> SingleValueFormat<TYPE>::getEffectiveValues(Tokens const &args,
+                                                           size_t        begin,
+                                                           size_t end) const
+{
+  if (begin + 1 < end && parser.isValue(args.at(begin + 1)))
+    return {parser.toCanonical(parser.parse(args.at(begin + 1)))};
+  return {parser.toCanonical(defaults)};
 }
@@ -0,0 +1,93 @@
+#include <ArgumentViewer/private/Snapshot.h>
+#include <cstring>
+
+char const     snapshotMagic[8] = {'A', 'R', 'G', 'V', 'S', 'N', 'A', 'P'};
+uint32_t const snapshotVersion  = 1;
+
+size_t getSnapshotSize(string const &applicationName, Tokens const &tokens)
+{
+  size_t size = sizeof(SnapshotHeader) + tokens.size() * sizeof(SnapshotToken);
+  size += applicationName.length();
+  for (auto const &x : tokens) size += x.text.length();
+  return size;
+}
+
+void writeSnapshot(void *        memory,
+                   string const &applicationName,
+                   Tokens const &tokens)
+{
+  auto const bytes   = static_cast<char *>(memory);
+  auto const header  = reinterpret_cast<SnapshotHeader *>(bytes);
+  auto const entries = reinterpret_cast<SnapshotToken *>(bytes + sizeof(SnapshotHeader));
+  size_t     offset  = sizeof(SnapshotHeader) + tokens.size() * sizeof(SnapshotToken);
+
+  memcpy(header->magic, snapshotMagic, sizeof(snapshotMagic));
+  header->version               = snapshotVersion;
+  header->nofTokens             = static_cast<uint32_t>(tokens.size());
+  header->size                  = getSnapshotSize(applicationName, tokens);
+  header->applicationNameOffset = offset;
+  header->applicationNameLength = applicationName.length();
+  memcpy(bytes + offset, applicationName.data(), applicationName.length());
+  offset += applicationName.length();
+
+  vector<uint32_t> openContexts;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    auto const &text  = tokens[i].text;
+    auto &      entry = entries[i];
+    entry.offset      = offset;
+    entry.length      = text.length();
+    entry.kind        = tokens[i].kind;
+    entry.closing     = header->nofTokens;
+    memcpy(bytes + offset, text.data(), text.length());
+    offset += text.length();
+    if (tokens[i].kind == Token::CONTEXT_BEGIN)
+      openContexts.push_back(static_cast<uint32_t>(i));
+    if (tokens[i].kind == Token::CONTEXT_END && !openContexts.empty()) {
+      entries[openContexts.back()].closing = static_cast<uint32_t>(i);
+      openContexts.pop_back();
+    }
+  }
+}
+
+namespace {
+// offset + length could wrap around
+bool isRangeInside(uint64_t offset, uint64_t length, uint64_t size)
+{
+  return offset <= size && length <= size - offset;
+}
+
+bool isKindValid(uint32_t kind)
+{
+  return kind <= Token::FILE_SYMBOL;
+}
+}  // namespace
+
+bool isSnapshotValid(void const *memory, size_t size)
+{
+  if (memory == nullptr || size < sizeof(SnapshotHeader)) return false;
+  if (reinterpret_cast<uintptr_t>(memory) % alignof(SnapshotHeader) != 0)
+    return false;
+  auto const header = static_cast<SnapshotHeader const *>(memory);
+  if (memcmp(header->magic, snapshotMagic, sizeof(snapshotMagic)) != 0)
+    return false;
+  if (header->version != snapshotVersion) return false;
+  if (header->size > size) return false;
+  size_t const textsOffset =
+      sizeof(SnapshotHeader) + size_t(header->nofTokens) * sizeof(SnapshotToken);
+  if (textsOffset > header->size) return false;
+  auto const entries = reinterpret_cast<SnapshotToken const *>(
+      static_cast<char const *>(memory) + sizeof(SnapshotHeader));
+  for (uint32_t i = 0; i < header->nofTokens; ++i) {
+    if (!isRangeInside(entries[i].offset, entries[i].length, header->size))
+      return false;
+    if (!isKindValid(entries[i].kind)) return false;
+    // escape character is skipped when value is read
+    if (entries[i].kind == Token::ESCAPED_VALUE && entries[i].length == 0)
+      return false;
+    if (entries[i].kind == Token::CONTEXT_BEGIN &&
+        (entries[i].closing <= i || entries[i].closing > header->nofTokens))
+      return false;
+  }
+  return isRangeInside(header->applicationNameOffset,
+                       header->applicationNameLength, header->size);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <ArgumentViewer/private/Token.h>
+#include <cstdint>
+
+/**
+ * @brief Layout of frozen arguments.
+ * Snapshot does not contain any pointer, all positions are offsets from its
+ * beginning, so it can be mapped by several processes at different addresses.
+ * [SnapshotHeader][SnapshotToken * nofTokens][texts]
+ */
+struct SnapshotHeader {
+  char     magic[8];
+  uint32_t version;
+  uint32_t nofTokens;
+  uint64_t size;
+  uint64_t applicationNameOffset;
+  uint64_t applicationNameLength;
+};
+
+struct SnapshotToken {
+  uint64_t offset;
+  uint64_t length;
+  uint32_t kind;
+  // index of matching context end for context begin, otherwise unused
+  uint32_t closing;
+};
+
+size_t getSnapshotSize(string const &applicationName, Tokens const &tokens);
+void   writeSnapshot(void *        memory,
+                     string const &applicationName,
+                     Tokens const &tokens);
+bool   isSnapshotValid(void const *memory, size_t size);
@@ -1,19 +1,18 @@
-#include <ArgumentViewer/Exception.h>
-#include <ArgumentViewer/private/Globals.h>
 #include <ArgumentViewer/private/LineSplitter.h>
 #include <ArgumentViewer/private/StringVectorFormat.h>
 #include <algorithm>
 
-using namespace argumentViewer::ex;
+using namespace argumentViewer;
 
 StringVectorFormat::StringVectorFormat(string const &        argument,
                                        vector<string> const &defs,
-                                       string const &        com)
-    : ValueFormat(argument, com), defaults(defs) {}
+                                       string const &        com,
+                                       Syntax const &        s)
+    : ValueFormat(argument, com), defaults(defs), syntax(s) {}
 
 string StringVectorFormat::getDefaults() const {
   LineSplitter splitter;
-  splitter.addString(contextBegin);
+  splitter.addString(string(1, syntax.contextBegin));
   bool first = true;
   for (auto const &x : defaults) {
     if (first)
@@ -22,7 +21,7 @@ string StringVectorFormat::getDefaults() const {
       splitter.addString(" ");
     splitter.addString(x);
   }
-  splitter.addString(contextEnd);
+  splitter.addString(string(1, syntax.contextEnd));
   return splitter.get();
 }
 
@@ -41,35 +40,54 @@ size_t StringVectorFormat::getDefaultsLength() const {
 
 string StringVectorFormat::getType() const { return "string*"; }
 
-void throwIfArgumentsDoesNotContainContextBegin(vector<string> const &args,size_t &index,string const&argumentName){
-  if (args.at(index) == contextBegin) return;
-  stringstream ss;
-  ss << "Argument error:" << endl;
-  ss << "expected " << contextBegin << " after argument: " << argumentName;
-  ss << " not argument: " << args.at(index);
-  throw MatchError(ss.str());
-}
-
-void throwIfArgumentsUbrupltlyEnds(vector<string> const &args,size_t &index,string const&argumentName){
-  if (index < args.size()) return;
-  stringstream ss;
-  ss << "Argument error:" << endl;
-  ss << "expected " << contextEnd
-     << " at the end of context argument: " << argumentName;
-  ss << " not end of arguments";
-  throw MatchError(ss.str());
-}
-
-Format::MatchStatus StringVectorFormat::match(vector<string> const &args,
-                                              size_t &index) const {
+Format::MatchStatus StringVectorFormat::match(Tokens const &        args,
+                                              size_t &              index,
+                                              Diagnostics &diagnostics) const {
   if (index >= args.size()) return MATCH_FAILURE;
-  size_t oldIndex = index;
-  if (args.at(index) != argumentName) return MATCH_FAILURE;
+  size_t const argumentIndex = index;
+  if (args.at(index).text != argumentName) return MATCH_FAILURE;
   ++index;
-  throwIfArgumentsDoesNotContainContextBegin(args,index,argumentName);
+  if (isContextBeginMissing(args, index)) {
+    addDiagnostic(diagnostics, Diagnostic::MISSING_CONTEXT_BEGIN, index,
+                  argumentIndex);
+    return MATCH_SUCCESS;
+  }
   ++index;
-  while (index < args.size() && args.at(index) != contextEnd) ++index;
-  throwIfArgumentsUbrupltlyEnds(args,index,argumentName);
+  while (index < args.size() && args.at(index).kind != Token::CONTEXT_END)
+    ++index;
+  if (index >= args.size()) {
+    addDiagnostic(diagnostics, Diagnostic::MISSING_CONTEXT_END, index,
+                  argumentIndex);
+    return MATCH_SUCCESS;
+  }
   ++index;
   return MATCH_SUCCESS;
 }
+
+bool StringVectorFormat::isOfType(FormatTypeId id) const
+{
+  return id == getFormatTypeId<StringVectorFormat>() || ValueFormat::isOfType(id);
+}
+
+bool StringVectorFormat::isValue(Token const &token) const
+{
+  return token.kind != Token::CONTEXT_END;
+}
+
+bool StringVectorFormat::hasMultipleValues() const { return true; }
+
+vector<string> StringVectorFormat::getEffectiveValues(Tokens const &args,
+                                                      size_t        begin,
+                                                      size_t        end) const
+{
+  vector<string> result;
+  bool const closed = end >= begin + 3 &&
+                      args.at(begin + 1).kind == Token::CONTEXT_BEGIN &&
+                      args.at(end - 1).kind == Token::CONTEXT_END;
+  if (!closed) return defaults;
+  for (size_t i = begin + 2; i + 1 < end; ++i)
+    result.push_back(args.at(i).getValue());
+  while (result.size() < defaults.size())
+    result.push_back(defaults.at(result.size()));
+  return result;
+}
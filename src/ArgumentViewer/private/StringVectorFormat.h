@@ -5,12 +5,21 @@
 class StringVectorFormat : public ValueFormat {
  public:
   vector<string> defaults;
+  argumentViewer::Syntax syntax;
   StringVectorFormat(string const &        argument,
                      vector<string> const &defs,
-                     string const &        com);
+                     string const &        com,
+                     argumentViewer::Syntax const &syntax);
   virtual string      getDefaults() const override;
   virtual size_t      getDefaultsLength() const override;
   virtual string      getType() const override;
-  virtual MatchStatus match(vector<string> const &args,
-                            size_t &              index) const override;
+  virtual MatchStatus match(Tokens const &        args,
+                            size_t &              index,
+                            Diagnostics &         diagnostics) const override;
+  virtual bool        isOfType(FormatTypeId id) const override;
+  virtual bool        isValue(Token const &token) const override;
+  virtual bool        hasMultipleValues() const override;
+  virtual vector<string> getEffectiveValues(Tokens const &args,
+                                            size_t        begin,
+                                            size_t        end) const override;
 };
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <ArgumentViewer/private/Token.h>
+
+/**
+ * @brief Values of one sweep, list values are stored, range values are
+ * created only when they are chosen
+ */
+struct SweepDimension {
+  // values of list, empty for range
+  Tokens values;
+  // range contains values first + i * step for i < nofValues
+  double first     = 0.;
+  double step      = 1.;
+  bool   integral  = true;
+  size_t nofValues = 0;
+};
+
+/**
+ * @brief Arguments of Sweep shared by all its configurations.
+ * Every sweep is replaced by one argument whose value is chosen
+ * by configuration.
+ */
+struct argumentViewer::SweepData {
+  string applicationName;
+  Syntax syntax;
+  Tokens arguments;
+  // matching context end of context begin
+  vector<size_t> closing;
+  // dimension of swept argument, noDimension for other arguments
+  vector<size_t> dimensions;
+  // values of every dimension
+  vector<SweepDimension> sweeps;
+  // product of numbers of values, 0 if it does not fit into size_t
+  size_t              nofConfigurations = 1;
+  static size_t const noDimension = size_t(-1);
+};
+
+/**
+ * @brief Chosen values of one configuration of Sweep
+ */
+struct argumentViewer::SweepChoices {
+  // index of chosen value of every dimension
+  vector<size_t> choices;
+  // chosen value of every dimension
+  Tokens values;
+};
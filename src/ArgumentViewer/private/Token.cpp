@@ -0,0 +1,93 @@
+#include <ArgumentViewer/private/Globals.h>
+#include <ArgumentViewer/private/Token.h>
+#include <cctype>
+
+using namespace argumentViewer;
+
+bool isDelimiter(char c, Syntax const &syntax)
+{
+  return c == syntax.contextBegin || c == syntax.contextEnd ||
+         c == syntax.fileSymbol;
+}
+
+Token::Kind classifyArgument(string const &argument, Syntax const &syntax)
+{
+  if (argument.length() == 1) {
+    if (argument[0] == syntax.contextBegin) return Token::CONTEXT_BEGIN;
+    if (argument[0] == syntax.contextEnd) return Token::CONTEXT_END;
+    if (argument[0] == syntax.fileSymbol) return Token::FILE_SYMBOL;
+  }
+  if (argument.length() == 2 && argument[0] == '\\' &&
+      isDelimiter(argument[1], syntax))
+    return Token::ESCAPED_VALUE;
+  // keywords of Sweep are escaped like delimiters
+  if (argument.length() > 1 && argument[0] == '\\' &&
+      (argument.compare(1, string::npos, sweepSymbol) == 0 ||
+       argument.compare(1, string::npos, rangeSymbol) == 0))
+    return Token::ESCAPED_VALUE;
+  return Token::VALUE;
+}
+
+Token::Token(string argument, Syntax const &syntax)
+    : text(std::move(argument)), kind(classifyArgument(text, syntax))
+{
+  if (kind == ESCAPED_VALUE) unescapedText = text.substr(1);
+}
+
+/**
+ * @brief Returns argument with resolved escape sequence
+ *
+ * @return value of argument
+ */
+string const &Token::getValue() const
+{
+  if (kind == ESCAPED_VALUE) return unescapedText;
+  return text;
+}
+
+bool Token::operator==(Token const &other) const { return text == other.text; }
+
+bool Token::operator!=(Token const &other) const { return !(*this == other); }
+
+bool isLongOptionWithValue(string const &argument, size_t &separator)
+{
+  if (argument.compare(0, 2, "--") != 0) return false;
+  separator = argument.find('=', 2);
+  return separator != string::npos && separator > 2;
+}
+
+bool isShortFlagBundle(string const &argument, string const &shortFlags)
+{
+  if (argument.length() < 3 || argument[0] != '-') return false;
+  for (size_t i = 1; i < argument.length(); ++i)
+    if (shortFlags.find(argument[i]) == string::npos) return false;
+  return true;
+}
+
+/**
+ * @brief Appends command line argument, --key=value is appended as two
+ * tokens --key value and bundled short flags -vq as -v -q
+ *
+ * @param tokens tokens
+ * @param argument command line argument
+ * @param syntax delimiters of arguments
+ * @param shortFlags letters of flags that can be bundled
+ */
+void appendGnuArgument(Tokens &      tokens,
+                       string const &argument,
+                       Syntax const &syntax,
+                       string const &shortFlags)
+{
+  size_t separator;
+  if (isLongOptionWithValue(argument, separator)) {
+    tokens.emplace_back(argument.substr(0, separator), syntax);
+    tokens.emplace_back(argument.substr(separator + 1), syntax);
+    return;
+  }
+  if (isShortFlagBundle(argument, shortFlags)) {
+    for (size_t i = 1; i < argument.length(); ++i)
+      tokens.emplace_back(string{'-', argument[i]}, syntax);
+    return;
+  }
+  tokens.emplace_back(argument, syntax);
+}
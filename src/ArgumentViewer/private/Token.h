@@ -0,0 +1,45 @@
+#pragma once
+
+#include <ArgumentViewer/Syntax.h>
+#include <ArgumentViewer/Value.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Argument classified when it is read from command line or file,
+ * so lookups and reads do not have to examine escape sequences again.
+ */
+struct Token {
+  enum Kind {
+    // ordinary argument
+    VALUE,
+    // argument with escaped context begin, context end, file symbol or
+    // keyword of Sweep
+    ESCAPED_VALUE,
+    CONTEXT_BEGIN,
+    CONTEXT_END,
+    FILE_SYMBOL,
+  };
+  Token(string argument = "", argumentViewer::Syntax const &syntax = {});
+  string text;
+  Kind   kind;
+  // text without escape character, it is set only for ESCAPED_VALUE
+  string unescapedText;
+  // value of user type parsed from text, nullptr if text is not value of
+  // parsedType, it is set by the first format that reads the token
+  mutable shared_ptr<argumentViewer::Value const> parsed;
+  mutable void const *                            parsedType = nullptr;
+  string const &getValue() const;
+  bool   operator==(Token const &other) const;
+  bool   operator!=(Token const &other) const;
+};
+
+typedef vector<Token> Tokens;
+
+void appendGnuArgument(Tokens &                       tokens,
+                       string const &                 argument,
+                       argumentViewer::Syntax const &syntax,
+                       string const &                 shortFlags);
@@ -0,0 +1,117 @@
+#include <ArgumentViewer/private/TraceImpl.h>
+#include <functional>
+#include <new>
+#include <thread>
+
+using namespace argumentViewer;
+
+TraceImpl::TraceImpl(size_t capacity)
+    : start(chrono::steady_clock::now()), spans(capacity == 0 ? 1 : capacity)
+{
+}
+
+uint64_t TraceImpl::getTime() const
+{
+  auto const duration = chrono::steady_clock::now() - start;
+  return chrono::duration_cast<chrono::nanoseconds>(duration).count();
+}
+
+void TraceImpl::add(Span &&span)
+{
+  lock_guard<mutex> lock(spansMutex);
+  spans[next] = std::move(span);
+  next        = (next + 1) % spans.size();
+  if (nofSpans < spans.size()) ++nofSpans;
+}
+
+size_t TraceImpl::getNofSpans() const
+{
+  lock_guard<mutex> lock(spansMutex);
+  return nofSpans;
+}
+
+void TraceImpl::clear()
+{
+  lock_guard<mutex> lock(spansMutex);
+  next     = 0;
+  nofSpans = 0;
+}
+
+namespace {
+void writeJsonString(ostream &stream, string const &text)
+{
+  static char const hex[] = "0123456789abcdef";
+  stream << '"';
+  for (auto const c : text) {
+    if (c == '"' || c == '\\')
+      stream << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      stream << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+    else
+      stream << c;
+  }
+  stream << '"';
+}
+
+void writeMicroseconds(ostream &stream, uint64_t nanoseconds)
+{
+  auto const fraction = nanoseconds % 1000;
+  stream << nanoseconds / 1000 << '.' << fraction / 100 << fraction / 10 % 10
+         << fraction % 10;
+}
+}  // namespace
+
+/**
+ * @brief Writes spans from the oldest one as complete events ("ph":"X")
+ * of Chrome trace event format.
+ */
+void TraceImpl::writeChromeTrace(ostream &stream) const
+{
+  lock_guard<mutex> lock(spansMutex);
+  stream << "{\"traceEvents\":[";
+  size_t const first = (next + spans.size() - nofSpans) % spans.size();
+  for (size_t i = 0; i < nofSpans; ++i) {
+    auto const &span = spans[(first + i) % spans.size()];
+    if (i > 0) stream << ',';
+    stream << "\n{\"name\":";
+    writeJsonString(stream, span.name);
+    stream << ",\"cat\":\"argumentViewer\",\"ph\":\"X\",\"ts\":";
+    writeMicroseconds(stream, span.begin);
+    stream << ",\"dur\":";
+    writeMicroseconds(stream, span.end - span.begin);
+    stream << ",\"pid\":1,\"tid\":" << span.thread << ",\"args\":{";
+    bool first = true;
+    if (span.key != "") {
+      stream << "\"key\":";
+      writeJsonString(stream, span.key);
+      first = false;
+    }
+    if (span.type != "") {
+      if (!first) stream << ',';
+      stream << "\"type\":";
+      writeJsonString(stream, span.type);
+    }
+    stream << "}}";
+  }
+  stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+string const TraceSpan::emptyKey;
+
+void TraceSpan::begin(char const *name, string const &key, string (*getType)())
+{
+  auto &span  = *new (&storage) Span;
+  span.name   = name;
+  span.key    = key;
+  if (getType) span.type = getType();
+  span.thread = hash<thread::id>()(this_thread::get_id()) % 1000000;
+  span.begin  = trace->getTime();
+}
+
+void TraceSpan::end()
+{
+  auto &span = *reinterpret_cast<Span *>(&storage);
+  span.end   = trace->getTime();
+  trace->add(std::move(span));
+  span.~Span();
+}
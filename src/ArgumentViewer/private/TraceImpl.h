@@ -0,0 +1,73 @@
+#pragma once
+
+#include <ArgumentViewer/Fwd.h>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+class argumentViewer::TraceImpl {
+ public:
+  struct Span {
+    char const *name = "";
+    string      key;
+    string      type;
+    uint64_t    begin  = 0;
+    uint64_t    end    = 0;
+    size_t      thread = 0;
+  };
+  TraceImpl(size_t capacity);
+  // nanoseconds since creation of trace
+  uint64_t getTime() const;
+  void     add(Span &&span);
+  size_t   getNofSpans() const;
+  void     writeChromeTrace(ostream &stream) const;
+  void     clear();
+
+ protected:
+  chrono::steady_clock::time_point const start;
+  mutable mutex                          spansMutex;
+  vector<Span>                           spans;
+  // position of the oldest span when ring buffer is full
+  size_t                                 next = 0;
+  size_t                                 nofSpans = 0;
+};
+
+/**
+ * @brief Records span from its construction to its destruction.
+ * If trace is nullptr, it does nothing, span is not even constructed.
+ * Type of value is obtained only if trace is recorded.
+ */
+class TraceSpan {
+ public:
+  TraceSpan(argumentViewer::TraceImpl *trace,
+            char const *               name,
+            string const &             key     = emptyKey,
+            string (*getType)()                = nullptr)
+      : trace(trace)
+  {
+    if (trace) begin(name, key, getType);
+  }
+  ~TraceSpan()
+  {
+    if (trace) end();
+  }
+  TraceSpan(TraceSpan const &) = delete;
+  TraceSpan &operator=(TraceSpan const &) = delete;
+
+ protected:
+  using Span = argumentViewer::TraceImpl::Span;
+  void                        begin(char const *  name,
+                                    string const &key,
+                                    string (*getType)());
+  void                        end();
+  static string const         emptyKey;
+  argumentViewer::TraceImpl * trace;
+  // span is constructed in storage only if trace is recorded
+  aligned_storage<sizeof(Span), alignof(Span)>::type storage;
+};
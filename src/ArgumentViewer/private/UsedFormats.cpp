@@ -0,0 +1,40 @@
+#include <ArgumentViewer/private/UsedFormats.h>
+#include <algorithm>
+
+/**
+ * @param list formats of list
+ * @param layerEnds ends of layers of arguments, empty for body of context
+ */
+UsedFormats::UsedFormats(ArgumentListFormat const &list,
+                         vector<size_t> const &    layerEnds)
+    : list(&list), layerEnds(layerEnds), used(layerEnds.size() + 1)
+{
+}
+
+/**
+ * @brief Marks format of argument as used in layer of argument
+ *
+ * @param name name of argument
+ * @param index index of argument
+ *
+ * @return format of argument or nullptr if argument is unknown or its
+ * format was already used in the same layer
+ */
+shared_ptr<Format> UsedFormats::use(string const &name, size_t index)
+{
+  auto const it = list->formats.find(name);
+  if (it == list->formats.end()) return nullptr;
+  if (!used[getLayer(index)].insert(name).second) return nullptr;
+  return it->second;
+}
+
+bool UsedFormats::isUsed(string const &name, size_t index) const
+{
+  return used[getLayer(index)].count(name) != 0;
+}
+
+size_t UsedFormats::getLayer(size_t index) const
+{
+  return upper_bound(layerEnds.begin(), layerEnds.end(), index) -
+         layerEnds.begin();
+}
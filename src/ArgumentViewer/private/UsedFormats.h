@@ -0,0 +1,29 @@
+#pragma once
+
+#include <ArgumentViewer/private/ArgumentListFormat.h>
+#include <memory>
+#include <set>
+#include <vector>
+
+/**
+ * @brief Formats of argument list that already matched an argument.
+ * Every matcher decides by it which format matches the next argument of list,
+ * so validation, ArgumentListFormat::match, Batch and PushMatcher agree.
+ * Arguments outside of contexts can be split into layers, an argument can
+ * be repeated in a lower layer.
+ */
+class UsedFormats {
+ public:
+  UsedFormats() = default;
+  UsedFormats(ArgumentListFormat const &list,
+              vector<size_t> const &    layerEnds = {});
+  shared_ptr<Format> use(string const &name, size_t index = 0);
+  bool               isUsed(string const &name, size_t index = 0) const;
+
+ protected:
+  size_t                    getLayer(size_t index) const;
+  ArgumentListFormat const *list = nullptr;
+  vector<size_t>            layerEnds;
+  // used names of every layer
+  vector<set<string>> used;
+};
@@ -62,3 +62,10 @@ string ValueFormat::toStr(size_t indent,
   writeLineEnd(ss);
   return ss.str();
 }
+
+bool ValueFormat::hasMultipleValues() const { return false; }
+
+bool ValueFormat::isOfType(FormatTypeId id) const
+{
+  return id == getFormatTypeId<ValueFormat>() || Format::isOfType(id);
+}
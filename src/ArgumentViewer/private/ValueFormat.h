@@ -11,8 +11,18 @@ class ValueFormat : public Format {
   virtual string      getDefaults() const = 0;
   virtual size_t      getDefaultsLength() const;
   virtual string      getType() const                     = 0;
-  virtual MatchStatus match(vector<string> const &args,
-                            size_t &              index) const override = 0;
+  virtual MatchStatus match(Tokens const &        args,
+                            size_t &              index,
+                            Diagnostics &         diagnostics) const override = 0;
+  virtual bool        isOfType(FormatTypeId id) const override;
+  // checks of one token, they are used by PushMatcher
+  virtual bool        isValue(Token const &token) const = 0;
+  virtual bool        hasMultipleValues() const;
+  // normalized values of argument matched at [begin,end) padded by defaults,
+  // only defaults if begin == end
+  virtual vector<string> getEffectiveValues(Tokens const &args,
+                                            size_t        begin,
+                                            size_t        end) const = 0;
   virtual string      toStr(size_t indent,
                             size_t maxNameSize,
                             size_t maxDefaultsSize,
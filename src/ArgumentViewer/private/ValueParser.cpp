@@ -0,0 +1,54 @@
+#include <ArgumentViewer/private/ValueParser.h>
+
+ValueParser<UserValue>::ValueParser(UserValue const &p) : prototype(p) {}
+
+string ValueParser<UserValue>::getType() const { return prototype->getType(); }
+
+bool ValueParser<UserValue>::isValue(Token const &token) const
+{
+  return parse(token) != nullptr;
+}
+
+/**
+ * @brief Parses token as value of type of prototype
+ *
+ * @param token token
+ *
+ * @return value, nullptr if token is not value of the type
+ */
+UserValue ValueParser<UserValue>::parse(Token const &token) const
+{
+  auto const type = prototype->getTypeId();
+  if (token.parsedType != type) {
+    token.parsed     = prototype->parse(token.getValue());
+    token.parsedType = type;
+  }
+  return token.parsed;
+}
+
+string ValueParser<UserValue>::toStr(UserValue const &value) const
+{
+  return value->toStr();
+}
+
+string ValueParser<UserValue>::toCanonical(UserValue const &value) const
+{
+  return value->toStr();
+}
+
+/**
+ * @brief Values have the same type if they have the same type id.
+ * Types are not compared by name, different types can have the same name.
+ */
+bool haveSameType(Value const &a, Value const &b)
+{
+  return a.getTypeId() == b.getTypeId();
+}
+
+bool areEqual(vector<UserValue> const &a, vector<UserValue> const &b)
+{
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); ++i)
+    if (!a[i]->isEqual(*b[i])) return false;
+  return true;
+}
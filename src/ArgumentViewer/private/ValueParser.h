@@ -0,0 +1,45 @@
+#pragma once
+
+#include <ArgumentViewer/Value.h>
+#include <ArgumentViewer/private/CommonFunctions.h>
+#include <ArgumentViewer/private/Token.h>
+#include <TxtUtils/TxtUtils.h>
+#include <memory>
+
+using namespace argumentViewer;
+
+/**
+ * @brief Reading of values of one type for SingleValueFormat and VectorFormat.
+ * Built-in types are read by functions of CommonFunctions.
+ */
+template <typename TYPE>
+struct ValueParser {
+  string getType() const { return typeName<TYPE>(); }
+  bool   isValue(Token const &token) const
+  {
+    return isValueConvertibleTo<TYPE>(token.getValue());
+  }
+  TYPE   parse(Token const &token) const { return str2val<TYPE>(token.getValue()); }
+  string toStr(TYPE const &value) const { return txtUtils::valueToString(value); }
+  string toCanonical(TYPE const &value) const { return val2canonical(value); }
+};
+
+typedef shared_ptr<Value const> UserValue;
+
+/**
+ * @brief Reading of values of user types, they are parsed by prototype.
+ * Parsed value is stored in token, so every token is parsed only once.
+ */
+template <>
+struct ValueParser<UserValue> {
+  ValueParser(UserValue const &prototype);
+  string    getType() const;
+  bool      isValue(Token const &token) const;
+  UserValue parse(Token const &token) const;
+  string    toStr(UserValue const &value) const;
+  string    toCanonical(UserValue const &value) const;
+  UserValue prototype;
+};
+
+bool haveSameType(Value const &a, Value const &b);
+bool areEqual(vector<UserValue> const &a, vector<UserValue> const &b);
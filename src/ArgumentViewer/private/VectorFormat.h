@@ -3,30 +3,41 @@
 #include <ArgumentViewer/private/CommonFunctions.h>
 #include <ArgumentViewer/private/LineSplitter.h>
 #include <ArgumentViewer/private/ValueFormat.h>
+#include <ArgumentViewer/private/ValueParser.h>
 #include <TxtUtils/TxtUtils.h>
 
 template <typename TYPE>
 class VectorFormat : public ValueFormat {
  public:
-  vector<TYPE> defaults;
-  VectorFormat(string const &      argument,
-               vector<TYPE> const &defs,
-               string const &      com);
+  vector<TYPE>      defaults;
+  ValueParser<TYPE> parser;
+  VectorFormat(string const &           argument,
+               vector<TYPE> const &     defs,
+               string const &           com,
+               ValueParser<TYPE> const &p = ValueParser<TYPE>());
   virtual string      getDefaults() const override;
   virtual size_t      getDefaultsLength() const override;
   virtual string      getType() const override;
-  virtual MatchStatus match(vector<string> const &args,
-                            size_t &              index) const override;
+  virtual MatchStatus match(Tokens const &        args,
+                            size_t &              index,
+                            Diagnostics &         diagnostics) const override;
+  virtual bool        isOfType(FormatTypeId id) const override;
+  virtual bool        isValue(Token const &token) const override;
+  virtual bool        hasMultipleValues() const override;
+  virtual vector<string> getEffectiveValues(Tokens const &args,
+                                            size_t        begin,
+                                            size_t        end) const override;
 
  private:
   void writeDefaultsToSplitter(LineSplitter &splitter) const;
 };
 
 template <typename TYPE>
-VectorFormat<TYPE>::VectorFormat(string const &      argument,
-                                 vector<TYPE> const &defs,
-                                 string const &      com)
-    : ValueFormat(argument, com), defaults(defs)
+VectorFormat<TYPE>::VectorFormat(string const &           argument,
+                                 vector<TYPE> const &     defs,
+                                 string const &           com,
+                                 ValueParser<TYPE> const &p)
+    : ValueFormat(argument, com), defaults(defs), parser(p)
 {
 }
 
@@ -39,7 +50,7 @@ void VectorFormat<TYPE>::writeDefaultsToSplitter(LineSplitter &splitter) const
       first = false;
     else
       splitter.addString(" ");
-    splitter.addString(txtUtils::valueToString(x));
+    splitter.addString(parser.toStr(x));
   }
 }
 
@@ -64,22 +75,55 @@ size_t VectorFormat<TYPE>::getDefaultsLength() const
 template <typename TYPE>
 string VectorFormat<TYPE>::getType() const
 {
-  return typeName<TYPE>() + "*";
+  return parser.getType() + "*";
 }
 
 template <typename TYPE>
-void moveIndexToTheAndOfArgumentsWithThisType(vector<string>const&args,size_t&index){
-  while (index < args.size() && isValueConvertibleTo<TYPE>(args.at(index)))
+void moveIndexToTheAndOfArgumentsWithThisType(ValueParser<TYPE> const&parser,Tokens const&args,size_t&index){
+  while (index < args.size() && parser.isValue(args.at(index)))
     ++index;
 }
 
 template <typename TYPE>
-Format::MatchStatus VectorFormat<TYPE>::match(vector<string> const &args,
-                                              size_t &              index) const
+Format::MatchStatus VectorFormat<TYPE>::match(Tokens const &        args,
+                                              size_t &              index,
+                                              Diagnostics &) const
 {
   if (index >= args.size()) return MATCH_FAILURE;
-  if (args.at(index) != argumentName) return MATCH_FAILURE;
+  if (args.at(index).text != argumentName) return MATCH_FAILURE;
   ++index;
-  moveIndexToTheAndOfArgumentsWithThisType<TYPE>(args,index);
+  moveIndexToTheAndOfArgumentsWithThisType(parser,args,index);
   return MATCH_SUCCESS;
 }
+
+template <typename TYPE>
+bool VectorFormat<TYPE>::isOfType(FormatTypeId id) const
+{
+  return id == getFormatTypeId<VectorFormat<TYPE>>() ||
+         ValueFormat::isOfType(id);
+}
+
+template <typename TYPE>
+bool VectorFormat<TYPE>::isValue(Token const &token) const
+{
+  return parser.isValue(token);
+}
+
+template <typename TYPE>
+bool VectorFormat<TYPE>::hasMultipleValues() const
+{
+  return true;
+}
+
+template <typename TYPE>
+vector<string> VectorFormat<TYPE>::getEffectiveValues(Tokens const &args,
+                                                      size_t        begin,
+                                                      size_t        end) const
+{
+  vector<string> result;
+  for (size_t i = begin + 1; i < end; ++i)
+    result.push_back(parser.toCanonical(parser.parse(args.at(i))));
+  while (result.size() < defaults.size())
+    result.push_back(parser.toCanonical(defaults.at(result.size())));
+  return result;
+}
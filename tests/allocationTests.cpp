@@ -0,0 +1,143 @@
+#include<ArgumentViewer/ArgumentViewer.h>
+#include<cstdlib>
+#include<new>
+#include<string>
+#include<vector>
+
+#include<catch.hpp>
+
+using namespace argumentViewer;
+using namespace std;
+
+//Regressions of performance usually show up as new allocations.
+//Budgets bound allocations per argument instead of pinning totals of one
+//standard library, lookups must not allocate per argument at all and
+//validation and help may allocate only a few times per argument.
+
+//every allocation of the process goes through this operator new
+size_t nofAllocations = 0;
+
+void*operator new(size_t size){
+  ++nofAllocations;
+  if(auto const ptr = std::malloc(size == 0 ? 1 : size))return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void*ptr)noexcept{
+  std::free(ptr);
+}
+
+void operator delete(void*ptr,size_t)noexcept{
+  std::free(ptr);
+}
+
+//counts allocations of one operation
+template<typename OPERATION>
+size_t countAllocations(OPERATION const&operation){
+  size_t const before = nofAllocations;
+  operation();
+  return nofAllocations - before;
+}
+
+//arguments: test --a0 0 ... --v 0 1 ... --s text --l { x0 x1 ... } --f ctx { --b0 0 ... }
+class Arguments{
+  public:
+    Arguments(size_t n){
+      add("test");
+      for(size_t i=0;i<n;++i){add("--a"+to_string(i));add(to_string(i));}
+      add("--v");
+      for(size_t i=0;i<n;++i)add(to_string(i));
+      add("--s");
+      add("string that does not fit into small string buffer");
+      add("--l");
+      add("{");
+      for(size_t i=0;i<n;++i)add("x"+to_string(i));
+      add("}");
+      add("--f");
+      add("ctx");
+      add("{");
+      for(size_t i=0;i<n;++i){add("--b"+to_string(i));add(to_string(i));}
+      add("}");
+      for(auto&x:texts)pointers.push_back(&x[0]);
+    }
+    int getArgc()const{return int(pointers.size());}
+    char**getArgv(){return pointers.data();}
+  protected:
+    void add(string const&text){texts.push_back(text);}
+    vector<string>texts;
+    vector<char*>pointers;
+};
+
+void registerArguments(ArgumentViewer const&a,size_t n){
+  for(size_t i=0;i<n;++i)a.getu32("--a"+to_string(i));
+  a.getu32v("--v");
+  a.gets("--s");
+  a.getsv("--l");
+  a.isPresent("--f");
+  auto const ctx = a.getContext("ctx");
+  for(size_t i=0;i<n;++i)ctx->getu32("--b"+to_string(i));
+}
+
+//maximal number of allocations of operation for n arguments
+struct Budget{
+  size_t fixed;
+  size_t perArgument;
+  size_t operator()(size_t n)const{return fixed + perArgument*n;}
+};
+
+//Containers grow geometrically, fixed part covers their growth at every size.
+//Returned string and vector are allocated once.
+Budget const construction  = {48,0};
+Budget const singleLookup  = { 0,0};
+Budget const stringLookup  = { 1,0};
+Budget const vectorLookup  = { 1,0};
+Budget const flagLookup    = { 0,0};
+Budget const contextAccess = {12,0};
+Budget const validation    = {32,3};
+Budget const help          = {32,8};
+
+SCENARIO("ArgumentViewer allocation budget tests"){
+  for(size_t const n:{1,10,100,1000}){
+    Arguments args(n);
+    shared_ptr<ArgumentViewer>a;
+    CAPTURE(n);
+    REQUIRE(countAllocations([&]{a = make_shared<ArgumentViewer>(args.getArgc(),args.getArgv());}) <= construction(n));
+    registerArguments(*a,n);
+    string const name = "--a"+to_string(n-1);
+    REQUIRE(countAllocations([&]{a->getu32(name);}) <= singleLookup(n));
+    REQUIRE(countAllocations([&]{a->getu32v("--v");}) <= vectorLookup(n));
+    REQUIRE(countAllocations([&]{a->gets("--s");}) <= stringLookup(n));
+    REQUIRE(countAllocations([&]{a->getsv("--l");}) <= vectorLookup(n));
+    REQUIRE(countAllocations([&]{a->isPresent("--f");}) <= flagLookup(n));
+    REQUIRE(countAllocations([&]{a->getContext("ctx");}) <= contextAccess(n));
+    size_t const firstValidation = countAllocations([&]{a->validate();});
+    REQUIRE(firstValidation <= validation(n));
+    //nothing has changed, matching is reused
+    REQUIRE(countAllocations([&]{a->validate();}) < firstValidation);
+    REQUIRE(countAllocations([&]{a->toStr();}) <= help(n));
+  }
+}
+
+struct Level{
+  int value;
+  bool operator==(Level const&other)const{return value==other.value;}
+};
+
+template<>struct argumentViewer::ValueTraits<Level>{
+  static std::string typeName(){return "level";}
+  static bool parse(std::string const&text,Level&level){
+    level.value = std::atoi(text.c_str());
+    return true;
+  }
+  static std::string toString(Level const&level){return std::to_string(level.value);}
+};
+
+SCENARIO("ArgumentViewer custom value allocation tests"){
+  char const*argv[] = {"test","--level","3"};
+  auto a = make_shared<ArgumentViewer>(3,(char**)argv);
+  REQUIRE(a->get<Level>("--level",Level{1}).value==3);
+  REQUIRE(a->get<Level>("--missing",Level{1}).value==1);
+  //registered values are read without copying default value to heap
+  REQUIRE(countAllocations([&]{a->get<Level>("--level",Level{1});}) == 0);
+  REQUIRE(countAllocations([&]{a->get<Level>("--missing",Level{1});}) == 0);
+}
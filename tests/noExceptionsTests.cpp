@@ -0,0 +1,75 @@
+#include<ArgumentViewer/ArgumentViewer.h>
+#include<iostream>
+#include<fstream>
+#include<cstdio>
+
+using namespace argumentViewer;
+using namespace std;
+
+//Catch needs exceptions, this test is built without them
+int nofFailures = 0;
+#define REQUIRE(x) if(!(x)){std::cerr<<__FILE__<<":"<<__LINE__<<": "<<#x<<" failed"<<std::endl;++nofFailures;}
+
+void basicTest(){
+  char const*args[] = {"test","a","1.3f","light","{","b","1","2","}","s","{","x","y","}"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  REQUIRE(a->getf32("a")==1.3f);
+  REQUIRE(a->getContext("light")->getu32v("b")==std::vector<uint32_t>({1,2}));
+  REQUIRE(a->getsv("s")==std::vector<std::string>({"x","y"}));
+  REQUIRE(a->validate()==true);
+  REQUIRE(a->getError().code==Error::NONE);
+}
+
+void errorTest(){
+  char const*args[] = {"test","a","1","b","<","missing.txt"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto settings = Settings();
+  settings.missingFilesAreErrors = true;
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args,settings);
+  REQUIRE(a->getError().code==Error::FILE_NOT_FOUND);
+  a->clearError();
+  REQUIRE(a->getu32("a",3)==1);
+  REQUIRE(a->getf32("a",3.f)==3.f);
+  REQUIRE(a->getError().code==Error::INCOMPATIBLE_DEFINITION);
+  a->clearError();
+  REQUIRE(a->getContext("a")->isPresent("c")==false);
+  REQUIRE(a->getError().code==Error::INCOMPATIBLE_DEFINITION);
+  a->clearError();
+  REQUIRE(a->validate()==false);
+  REQUIRE(a->getError().code==Error::MATCH_ERROR);
+  REQUIRE(a->diagnose().size()==1);
+  a->clearError();
+  a->getContext("light")->validate();
+  REQUIRE(a->getError().code==Error::SUB_VIEWER_OPERATION);
+}
+
+void fileLoopTest(){
+  std::ofstream("noExceptionsLoop.txt")<<"a < noExceptionsLoop.txt"<<std::endl;
+  char const*args[] = {"test","<","noExceptionsLoop.txt","b"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  REQUIRE(a->getError().code==Error::FILE_LOADING_LOOP);
+  REQUIRE(a->isPresent("a")==true);
+  REQUIRE(a->isPresent("b")==true);
+}
+
+void limitTest(){
+  std::ofstream("noExceptionsLimit.txt")<<"a { { { } } }"<<std::endl;
+  char const*args[] = {"test","b","<","noExceptionsLimit.txt"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto settings = Settings();
+  settings.limits.maxNestingDepth = 2;
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args,settings);
+  REQUIRE(a->getError().code==Error::LIMIT_EXCEEDED);
+  REQUIRE(a->getNofArguments()==0);
+  std::remove("noExceptionsLimit.txt");
+}
+
+int main(){
+  basicTest();
+  errorTest();
+  fileLoopTest();
+  limitTest();
+  return nofFailures != 0;
+}
@@ -0,0 +1,197 @@
+#include<ArgumentViewer/ArgumentViewer.h>
+#include<ArgumentViewer/Batch.h>
+#include<algorithm>
+#include<numeric>
+#include<chrono>
+#include<cmath>
+#include<cstdio>
+#include<fstream>
+#include<string>
+#include<thread>
+#include<vector>
+
+#include<catch.hpp>
+
+using namespace argumentViewer;
+using namespace std;
+
+//Operations that should be linear are run with 10^3 ... 10^6 tokens or formats.
+//Exponent of growth is fitted to medians of measured times, quadratic paths
+//have exponent near 2, linear ones near 1. The limit leaves a margin for
+//noise of shared machines and still separates them.
+
+//formats are more expensive than tokens, they are measured up to 10^5
+size_t const maxNofTokens  = 1000000;
+size_t const maxNofFormats = 100000;
+double const maxExponent = 1.6;
+double const maxSeconds  = 1.;
+
+//median of seconds of one run, short runs are repeated to measure them
+//precisely, long runs are measured fewer times
+template<typename OPERATION>
+double measure(OPERATION const&operation){
+  using clock = chrono::steady_clock;
+  vector<double>times;
+  size_t nofBatches = 5;
+  for(size_t batch=0;batch<nofBatches;++batch){
+    size_t runs = 0;
+    auto const start = clock::now();
+    double elapsed = 0.;
+    do{
+      operation();
+      ++runs;
+      elapsed = chrono::duration<double>(clock::now()-start).count();
+    }while(elapsed < 0.02);
+    times.push_back(elapsed/runs);
+    if(elapsed > 0.1)nofBatches = 3;
+  }
+  nth_element(times.begin(),times.begin()+times.size()/2,times.end());
+  return times[times.size()/2];
+}
+
+//least squares fit of log(time) = exponent*log(size) + c
+template<typename OPERATION>
+double getGrowthExponent(size_t maxSize,OPERATION const&operation){
+  vector<double>xs;
+  vector<double>ys;
+  for(size_t n=1000;n<=maxSize;n*=10){
+    xs.push_back(log(double(n)));
+    double const seconds = measure([&]{operation(n);});
+    ys.push_back(log(seconds));
+    //superlinear operation would take too long with larger sizes
+    if(seconds > maxSeconds)break;
+  }
+  double const mx = accumulate(xs.begin(),xs.end(),0.)/xs.size();
+  double const my = accumulate(ys.begin(),ys.end(),0.)/ys.size();
+  double sxy = 0.;
+  double sxx = 0.;
+  for(size_t i=0;i<xs.size();++i){
+    sxy += (xs[i]-mx)*(ys[i]-my);
+    sxx += (xs[i]-mx)*(xs[i]-mx);
+  }
+  return sxy/sxx;
+}
+
+class Arguments{
+  public:
+    Arguments(){add("test");}
+    void add(string const&text){texts.push_back(text);}
+    shared_ptr<ArgumentViewer>create(Settings const&settings = Settings()){
+      vector<char*>pointers;
+      for(auto&x:texts)pointers.push_back(&x[0]);
+      return make_shared<ArgumentViewer>(int(pointers.size()),pointers.data(),settings);
+    }
+  protected:
+    vector<string>texts;
+};
+
+//--a0 0 --a1 1 ... n tokens
+Arguments getValueArguments(size_t n){
+  Arguments result;
+  for(size_t i=0;i<n/2;++i){result.add("--a"+to_string(i));result.add(to_string(i));}
+  return result;
+}
+
+void registerValueArguments(ArgumentViewer const&a,size_t n){
+  for(size_t i=0;i<n/2;++i)a.getu32("--a"+to_string(i));
+}
+
+SCENARIO("ArgumentViewer scaling tests"){
+  std::ofstream("scaling.txt")<<"--a 1 --b 2 c { d e } f g"<<std::endl;
+
+  WHEN("arguments are constructed"){
+    REQUIRE(getGrowthExponent(maxNofTokens,[](size_t n){getValueArguments(n).create();}) < maxExponent);
+  }
+  WHEN("argument files are loaded"){
+    REQUIRE(getGrowthExponent(maxNofTokens,[](size_t n){
+      Arguments args;
+      for(size_t i=0;i<n/10;++i){args.add("<");args.add("scaling.txt");}
+      args.create();
+    }) < maxExponent);
+  }
+  WHEN("lazy argument files are resolved"){
+    Settings settings;
+    settings.lazyIncludes = true;
+    REQUIRE(getGrowthExponent(maxNofTokens,[&](size_t n){
+      Arguments args;
+      for(size_t i=0;i<n/10;++i){args.add("<");args.add("scaling.txt");}
+      auto const a = args.create(settings);
+      a->getu32("--a");
+      a->getu32("--missing");
+    }) < maxExponent);
+  }
+  WHEN("every argument is looked up"){
+    REQUIRE(getGrowthExponent(maxNofFormats,[](size_t n){
+      auto const a = getValueArguments(n).create();
+      registerValueArguments(*a,n);
+    }) < maxExponent);
+  }
+  WHEN("arguments are validated"){
+    REQUIRE(getGrowthExponent(maxNofFormats,[](size_t n){
+      auto const a = getValueArguments(n).create();
+      registerValueArguments(*a,n);
+      a->validate();
+    }) < maxExponent);
+  }
+  WHEN("help is written"){
+    REQUIRE(getGrowthExponent(maxNofFormats,[](size_t n){
+      auto const a = getValueArguments(n).create();
+      registerValueArguments(*a,n);
+      a->toStr();
+    }) < maxExponent);
+  }
+  WHEN("help with long defaults is written"){
+    REQUIRE(getGrowthExponent(maxNofTokens,[](size_t n){
+      auto const a = getValueArguments(0).create();
+      a->getu32v("--v",vector<uint32_t>(n,7));
+      a->toStr();
+    }) < maxExponent);
+  }
+  WHEN("context is accessed"){
+    REQUIRE(getGrowthExponent(maxNofTokens,[](size_t n){
+      Arguments args;
+      args.add("ctx");
+      args.add("{");
+      args.add("--s");
+      args.add("{");
+      for(size_t i=0;i<n;++i)args.add("x");
+      args.add("}");
+      args.add("}");
+      args.create()->getContext("ctx")->getsv("--s");
+    }) < maxExponent);
+  }
+  WHEN("changed arguments are found by reload"){
+    REQUIRE(getGrowthExponent(maxNofFormats,[](size_t n){
+      auto const write = [&](size_t value){
+        std::ofstream file("reload.txt");
+        for(size_t i=0;i<n/2;++i)file<<"--a"<<i<<" "<<value<<" ";
+      };
+      write(0);
+      Arguments args;
+      args.add("<");
+      args.add("reload.txt");
+      auto const a = args.create();
+      registerValueArguments(*a,n);
+      write(1);
+      a->reload();
+    }) < maxExponent);
+    std::remove("reload.txt");
+  }
+  WHEN("job lines are parsed in batch"){
+    auto const a = getValueArguments(0).create();
+    registerValueArguments(*a,20);
+    //every line has 20 tokens
+    auto const getLines = [](size_t n){
+      string line;
+      for(size_t i=0;i<10;++i)line += "--a"+to_string(i)+" "+to_string(i)+" ";
+      return vector<string>(n/20,line);
+    };
+    REQUIRE(getGrowthExponent(maxNofTokens,[&](size_t n){Batch(*a,1).parseLines(getLines(n));}) < maxExponent);
+    //speedup depends on load of machine, it is only reported
+    auto const lines = getLines(maxNofTokens);
+    double const single   = measure([&]{Batch(*a,1).parseLines(lines);});
+    double const parallel = measure([&]{Batch(*a,4).parseLines(lines);});
+    WARN("speedup of 4 threads on "<<thread::hardware_concurrency()<<" cores: "<<single/parallel);
+  }
+  std::remove("scaling.txt");
+}
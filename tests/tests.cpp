@@ -1,6 +1,20 @@
 #include<ArgumentViewer/ArgumentViewer.h>
+#include<ArgumentViewer/Batch.h>
+#include<ArgumentViewer/BasicArgumentViewer.h>
+#include<ArgumentViewer/Exception.h>
+#include<ArgumentViewer/PushMatcher.h>
+#include<ArgumentViewer/SharedSnapshot.h>
+#include<ArgumentViewer/SnapshotViewer.h>
+#include<ArgumentViewer/Sweep.h>
+#include<ArgumentViewer/Trace.h>
 #include<iostream>
 #include<fstream>
+#include<algorithm>
+#include<cstdio>
+#include<cstdlib>
+#include<cstring>
+#include<sstream>
+#include<stdexcept>
 
 #include<catch.hpp>
 
@@ -185,6 +199,948 @@ SCENARIO("ArgumentViewer file tests"){
   //std::cerr<<a->toStr()<<std::endl;
 }
 
+SCENARIO("ArgumentViewer lazy file tests"){
+  std::ofstream("lazy0.txt")<<"a b c < lazy1.txt"<<std::endl;
+  std::ofstream("lazy1.txt")<<"position { a b }"<<std::endl;
+  std::ofstream("lazy2.txt")<<"--value 12"<<std::endl;
+  char const*args[] = {"test","a","unused","{","<","missing.txt","}","light","{","<","lazy0.txt","}","<","lazy2.txt","b"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto settings = Settings();
+  settings.lazyIncludes = true;
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args,settings);
+  REQUIRE(a->isPresent("a")==true );
+  REQUIRE(a->isPresent("b")==true );
+  REQUIRE(a->geti32("--value")==12);
+  REQUIRE(a->getContext("light")->isPresent("c")==true);
+  REQUIRE(a->getContext("light")->getContext("position")->isPresent("b")==true);
+  REQUIRE_THROWS(a->validate());
+}
+
+SCENARIO("ArgumentViewer lazy file loop tests"){
+  std::ofstream("loop0.txt")<<"a < loop1.txt"<<std::endl;
+  std::ofstream("loop1.txt")<<"b < loop0.txt"<<std::endl;
+  char const*args[] = {"test","<","loop0.txt"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto settings = Settings();
+  settings.lazyIncludes = true;
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args,settings);
+  REQUIRE(a->isPresent("a")==true);
+  REQUIRE_THROWS_AS(a->isPresent("c"),ex::Exception);
+}
+
+SCENARIO("ArgumentViewer reload tests"){
+  std::ofstream("tuning.txt")<<"width 10 light { color 1 0 0 }"<<std::endl;
+  char const*args[] = {"test","height","2","<","tuning.txt"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto settings = Settings();
+  settings.pathSeparator = '.';
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args,settings);
+  //without paths, context is reported instead of its arguments
+  auto b = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  b->getContext("light")->getf32v("color");
+  REQUIRE(a->getu32("width")==10);
+  REQUIRE(a->getu32("height")==2);
+  REQUIRE(a->getContext("light")->getf32v("color")==std::vector<float>({1.f,0.f,0.f}));
+  REQUIRE(a->reload().empty());
+  std::ofstream("tuning.txt")<<"width 1024 light { color 0 1 0 1 }"<<std::endl;
+  REQUIRE(a->reload()==std::vector<std::string>({"light.color","width"}));
+  REQUIRE(b->reload()==std::vector<std::string>({"light"}));
+  REQUIRE(a->getu32("width")==1024);
+  REQUIRE(a->getu32("height")==2);
+  REQUIRE(a->getContext("light")->getf32v("color")==std::vector<float>({0.f,1.f,0.f,1.f}));
+  // edit of the same size right after reload can keep the time stamp
+  std::ofstream("tuning.txt")<<"width 2048 light { color 0 1 0 1 }"<<std::endl;
+  REQUIRE(a->reload()==std::vector<std::string>({"width"}));
+  REQUIRE(a->getu32("width")==2048);
+  REQUIRE(a->reload().empty());
+  // only comments and formatting change, arguments stay matched
+  REQUIRE(a->validate());
+  std::ofstream("tuning.txt")<<"width 2048 # wider\nlight {\n  color 0 1 0 1\n}"<<std::endl;
+  REQUIRE(a->reload().empty());
+  REQUIRE(a->validate());
+  REQUIRE(a->getContext("light")->getf32v("color")==std::vector<float>({0.f,1.f,0.f,1.f}));
+  REQUIRE(a->getProvenance(4).line==2);
+  //removed file is empty file
+  std::remove("tuning.txt");
+  REQUIRE(a->reload()==std::vector<std::string>({"light","width"}));
+  REQUIRE(a->getu32("width")==0);
+  REQUIRE(a->getu32("height")==2);
+}
+
+SCENARIO("ArgumentViewer diagnose tests"){
+  char const*args[] = {"test","--width","abc","unknown","{","x","}","light","{","--bogus","--height"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  a->getu32("--width");
+  a->getContext("light")->getu32("--height");
+  auto const diagnostics = a->diagnose();
+  REQUIRE(diagnostics.size()==5);
+  REQUIRE(diagnostics[0].kind==Diagnostic::INCOMPATIBLE_VALUE);
+  REQUIRE(diagnostics[0].index==1);
+  REQUIRE(diagnostics[0].argumentIndex==0);
+  REQUIRE(a->getType(diagnostics[0])=="u32");
+  REQUIRE(diagnostics[1].kind==Diagnostic::UNKNOWN_ARGUMENT);
+  REQUIRE(diagnostics[1].index==2);
+  REQUIRE(diagnostics[2].kind==Diagnostic::UNKNOWN_ARGUMENT);
+  REQUIRE(a->getArgument(diagnostics[2].argumentIndex)=="--bogus");
+  REQUIRE(diagnostics[3].kind==Diagnostic::MISSING_VALUE);
+  REQUIRE(diagnostics[3].index==10);
+  REQUIRE(diagnostics[4].kind==Diagnostic::MISSING_CONTEXT_END);
+  REQUIRE(a->getArgument(diagnostics[4].argumentIndex)=="light");
+  REQUIRE(a->getMessage(diagnostics[0])=="Single value argument: --width should be followed by value of type: u32 not by: abc");
+  REQUIRE_THROWS_AS(a->validate(),ex::MatchError);
+  //diagnostics do not refer to viewer
+  a = nullptr;
+  REQUIRE(diagnostics[3].type=="u32");
+  REQUIRE(diagnostics[1].type=="");
+}
+
+struct Resolution{
+  uint32_t width;
+  uint32_t height;
+  bool operator==(Resolution const&other)const{return width==other.width&&height==other.height;}
+};
+
+size_t nofResolutionParses = 0;
+
+template<>struct argumentViewer::ValueTraits<Resolution>{
+  static std::string typeName(){return "resolution";}
+  static bool parse(std::string const&text,Resolution&value){
+    ++nofResolutionParses;
+    unsigned w,h;char x;char rest;
+    if(sscanf(text.c_str(),"%u%c%u%c",&w,&x,&h,&rest)!=3||x!='x')return false;
+    value.width  = w;
+    value.height = h;
+    return true;
+  }
+  static std::string toString(Resolution const&value){
+    return std::to_string(value.width)+"x"+std::to_string(value.height);
+  }
+};
+
+//value of the same type created in other shared library can have other id
+class ForeignResolution: public TypedValue<Resolution>{
+  public:
+    ForeignResolution(Resolution const&v):TypedValue<Resolution>(v){}
+    virtual void const*getTypeId()const override{static char const foreignId = 0;return &foreignId;}
+};
+
+SCENARIO("ArgumentViewer custom value tests"){
+  char const*args[] = {"test","--window","1920x1080","--tiles","16x16","32x8","--bad","12"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  nofResolutionParses = 0;
+  auto const window = a->get<Resolution>("--window",Resolution{640,480},"window size");
+  REQUIRE(window.width==1920);
+  REQUIRE(window.height==1080);
+  REQUIRE(a->get<Resolution>("--window",Resolution{640,480}).width==1920);
+  REQUIRE(nofResolutionParses==1);
+  //type names are not used for identification of types
+  REQUIRE_THROWS_AS(a->getValue("--window",ForeignResolution(Resolution{640,480})),ex::Exception);
+  auto const tiles = a->getv<Resolution>("--tiles",{Resolution{1,1},Resolution{2,2},Resolution{4,4}});
+  REQUIRE(tiles.size()==3);
+  REQUIRE(tiles[1].width==32);
+  REQUIRE(tiles[2].width==4);
+  REQUIRE(a->get<Resolution>("--bad",Resolution{1,2}).height==2);
+  REQUIRE(a->get<Resolution>("--missing",Resolution{3,4}).width==3);
+  REQUIRE_THROWS(a->getu32("--window"));
+  REQUIRE_THROWS(a->get<Resolution>("--window",Resolution{1,1}));
+  size_t const nofParses = nofResolutionParses;
+  auto const diagnostics = a->diagnose();
+  //validation uses values parsed by reads
+  REQUIRE(nofResolutionParses==nofParses);
+  REQUIRE(diagnostics.size()==1);
+  REQUIRE(diagnostics[0].kind==Diagnostic::INCOMPATIBLE_VALUE);
+  REQUIRE(a->getType(diagnostics[0])=="resolution");
+  auto const help = a->toStr();
+  REQUIRE(help.find("640x480")!=std::string::npos);
+  REQUIRE(help.find("[resolution*]")!=std::string::npos);
+}
+
+SCENARIO("ArgumentViewer snapshot tests"){
+  char const*args[] = {"test","--width","1024","light","{","--width","3","color","0","1","0.5","info","{","\\{","}","}","names","{","a","\\<","}","--height","768"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  std::vector<uint64_t>memory((a->getSnapshotSize()+7)/8);
+  a->writeSnapshot(memory.data());
+  auto s = SnapshotViewer::attach(memory.data(),a->getSnapshotSize());
+  REQUIRE(s != nullptr);
+  REQUIRE(s->getApplicationName()=="test");
+  REQUIRE(s->getNofArguments()==nofArgs-1);
+  REQUIRE(s->getu32("--width")==1024);
+  REQUIRE(s->getu32("--height")==768);
+  REQUIRE(s->isPresent("color")==false);
+  REQUIRE(s->getContext("light")->getu32("--width")==3);
+  REQUIRE(s->getContext("light")->getf32v("color")==std::vector<float>({0.f,1.f,.5f}));
+  REQUIRE(s->getContext("light")->getContext("info")->getArgument(0)=="\\{");
+  REQUIRE(s->getsv("names")==std::vector<std::string>({"a","<"}));
+  REQUIRE(s->getContext("missing")->getNofArguments()==0);
+  REQUIRE(SnapshotViewer::attach(memory.data(),8)==nullptr);
+  auto shared = SharedSnapshot::publish(*a);
+  REQUIRE(shared != nullptr);
+  REQUIRE(shared->getViewer()->getContext("light")->getu32("--width")==3);
+}
+
+SCENARIO("ArgumentViewer corrupted snapshot tests"){
+  char const*args[] = {"test","--width","1024"};
+  auto a = make_shared<ArgumentViewer>(3,(char**)args);
+  size_t const size = a->getSnapshotSize();
+  std::vector<uint64_t>memory((size+7)/8);
+  a->writeSnapshot(memory.data());
+  REQUIRE(SnapshotViewer::attach(memory.data(),size)!=nullptr);
+  //header: magic, version and nofTokens, size, name offset, name length
+  //the first token: offset, length, kind and closing
+  auto corrupted = memory;
+  corrupted[6] = ~uint64_t(0);
+  REQUIRE(SnapshotViewer::attach(corrupted.data(),size)==nullptr);
+  corrupted = memory;
+  corrupted[4] = ~uint64_t(0);
+  REQUIRE(SnapshotViewer::attach(corrupted.data(),size)==nullptr);
+  corrupted = memory;
+  uint32_t const kind = 1000;
+  std::memcpy(reinterpret_cast<char*>(corrupted.data())+7*8,&kind,sizeof(kind));
+  REQUIRE(SnapshotViewer::attach(corrupted.data(),size)==nullptr);
+}
+
+struct ShellSyntax{
+  static char const contextBegin = '[';
+  static char const contextEnd   = ']';
+  static char const fileSymbol   = '@';
+};
+
+SCENARIO("ArgumentViewer syntax policy tests"){
+  std::ofstream("syntax.txt")<<"--height 2 light [ color 1 0 ] # comment\n";
+  char const*args[] = {"test","--width","{","names","[","a","\\]","{","]","@","syntax.txt"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto a = make_shared<BasicArgumentViewer<ShellSyntax>>(nofArgs,(char**)args);
+  REQUIRE(a->gets("--width")=="{");
+  REQUIRE(a->getsv("names")==std::vector<std::string>({"a","]","{"}));
+  REQUIRE(a->getu32("--height")==2);
+  REQUIRE(a->getContext("light")->getf32v("color")==std::vector<float>({1.f,0.f}));
+  REQUIRE(a->validate());
+  REQUIRE(a->toStr().find("light [")!=std::string::npos);
+  std::remove("syntax.txt");
+}
+
+SCENARIO("ArgumentViewer gnu options tests"){
+  char const*args[] = {"test","--width=1024","-vq","--name==x","-12","light","{","--size=3","}","--title","-foo","--min","-inf"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto settings = Settings();
+  settings.gnuOptions = true;
+  settings.shortFlags = "vqo";
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args,settings);
+  REQUIRE(a->getNofArguments()==16);
+  REQUIRE(a->getu32("--width")==1024);
+  REQUIRE(a->isPresent("-v"));
+  REQUIRE(a->isPresent("-q"));
+  REQUIRE(a->gets("--name")=="=x");
+  REQUIRE(a->gets("--title")=="-foo");
+  REQUIRE(a->gets("--min")=="-inf");
+  REQUIRE(a->isPresent("-12"));
+  REQUIRE(a->getContext("light")->getu32("--size")==3);
+  REQUIRE(a->validate());
+  auto b = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  REQUIRE(b->getNofArguments()==nofArgs-1);
+}
+
+SCENARIO("ArgumentViewer incremental validation tests"){
+  char const*args[] = {"test","--width","1","--plugin","2","light","{","--size","3","--color","1","0","}","shadow","{","--bias","0.1","}","--flag","--last"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto registerCore = [](ArgumentViewer&a){
+    a.getu32("--width");
+    a.getContext("light")->getu32("--size");
+  };
+  auto registerPlugins = [](ArgumentViewer&a){
+    a.getu32("--plugin");
+    a.getContext("light")->getf32v("--color");
+    a.getContext("shadow")->getf32("--bias");
+    a.gets("--flag");
+  };
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  registerCore(*a);
+  REQUIRE(a->diagnose().size()==8);
+  registerPlugins(*a);
+  auto const incremental = a->diagnose();
+  auto b = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  registerCore(*b);
+  registerPlugins(*b);
+  auto const fromScratch = b->diagnose();
+  REQUIRE(incremental.size()==fromScratch.size());
+  REQUIRE(incremental.size()==0);
+  a->isPresent("--last");
+  b->isPresent("--last");
+  REQUIRE(a->diagnose().size()==b->diagnose().size());
+  REQUIRE(a->validate());
+}
+
+SCENARIO("ArgumentViewer push matcher tests"){
+  char const*args[] = {"console"};
+  auto a = make_shared<ArgumentViewer>(1,(char**)args);
+  a->getu32("--width");
+  a->isPresent("--quit");
+  a->getContext("light")->getf32v("--color");
+  a->getContext("light")->getsv("--tags");
+  auto m = make_shared<PushMatcher>(*a);
+  REQUIRE(m->getState().nextArguments==std::vector<std::string>({"--quit","--width","light"}));
+  auto s = m->push("--width");
+  REQUIRE(s.valueRequired);
+  REQUIRE(s.expectedType=="u32");
+  REQUIRE(!s.complete);
+  REQUIRE(m->push("abc").status==PushState::INCOMPATIBLE_VALUE);
+  s = m->push("light");
+  REQUIRE(s.nextArguments==std::vector<std::string>({"{"}));
+  s = m->push("{");
+  REQUIRE(s.contexts==std::vector<std::string>({"light"}));
+  REQUIRE(s.nextArguments==std::vector<std::string>({"--color","--tags","}"}));
+  s = m->push("--color");
+  REQUIRE(s.expectedType=="f32*");
+  REQUIRE(m->push("1").status==PushState::ACCEPTED);
+  s = m->push("--tags");
+  REQUIRE(s.nextArguments==std::vector<std::string>({"{"}));
+  REQUIRE(m->push("{").status==PushState::ACCEPTED);
+  REQUIRE(m->push("a").expectedType=="string");
+  REQUIRE(m->push("}").contexts.size()==1);
+  s = m->push("}");
+  REQUIRE(s.contexts.empty());
+  REQUIRE(s.complete);
+  REQUIRE(s.nextArguments==std::vector<std::string>({"--quit"}));
+  REQUIRE(m->push("--bogus").status==PushState::UNKNOWN_ARGUMENT);
+  REQUIRE(m->push("{").status==PushState::UNKNOWN_ARGUMENT);
+  REQUIRE(m->push("--quit").status==PushState::UNKNOWN_ARGUMENT);
+  REQUIRE(m->push("}").complete);
+  REQUIRE(m->push("--quit").status==PushState::ACCEPTED);
+  m->reset();
+  REQUIRE(m->getState().nextArguments.size()==3);
+}
+
+SCENARIO("ArgumentViewer sweep tests"){
+  std::ofstream("sweep.txt")<<"--samples sweep { 1 2 4 8 }\nlight { --intensity range { 0.5 1.5 0.5 } }\n";
+  char const*args[] = {"test","--resolution","range","{","512","1024","512","}","--name","base","<","sweep.txt"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  auto const sweep = Sweep(*a);
+  REQUIRE(sweep.getNofDimensions()==3);
+  REQUIRE(sweep.getNofValues(0)==2);
+  REQUIRE(sweep.getNofValues(1)==4);
+  REQUIRE(sweep.getNofValues(2)==3);
+  REQUIRE(sweep.getNofConfigurations()==24);
+  auto const c = sweep.getConfiguration(1+2*2+2*4*1);
+  REQUIRE(c->getu32("--resolution")==1024);
+  REQUIRE(c->getu32("--samples")==4);
+  REQUIRE(c->getContext("light")->getf32("--intensity")==1.f);
+  REQUIRE(c->gets("--name")=="base");
+  REQUIRE(c->getNofArguments()==11);
+  REQUIRE(sweep.getConfiguration(0)->getu32("--samples")==1);
+  REQUIRE(sweep.getConfiguration(23)->getContext("light")->getf32("--intensity")==1.5f);
+  std::remove("sweep.txt");
+  //escaped keywords are plain values
+  char const*escaped[] = {"test","--mode","\\range","{","1","3","}","--kind","sweep","{","\\sweep","\\range","}"};
+  auto const e = make_shared<ArgumentViewer>(int(sizeof(escaped)/sizeof(char const*)),(char**)escaped);
+  REQUIRE(e->gets("--mode")=="range");
+  auto const escapedSweep = Sweep(*e);
+  REQUIRE(escapedSweep.getNofDimensions()==1);
+  REQUIRE(escapedSweep.getNofValues(0)==2);
+  REQUIRE(escapedSweep.getConfiguration(0)->gets("--mode")=="range");
+  REQUIRE(escapedSweep.getConfiguration(0)->gets("--kind")=="sweep");
+  REQUIRE(escapedSweep.getConfiguration(1)->gets("--kind")=="range");
+}
+
+SCENARIO("ArgumentViewer sweep range limits tests"){
+  char const*args[] = {"test","--a","range","{","0","inf","}","--b","range","{","0","1","1e-300","}","--c","range","{","0","4e9","}"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  auto const sweep = Sweep(*a);
+  //ranges with infinite or too many values are not sweeps
+  REQUIRE(sweep.getNofDimensions()==1);
+  //values of range are created only for requested configuration
+  REQUIRE(sweep.getNofValues(0)==4000000001ull);
+  REQUIRE(sweep.getConfiguration(4000000000ull)->getu64("--c")==4000000000ull);
+  char const*huge[] = {"test","--a","range","{","0","4e9","}","--b","range","{","0","4e9","}","--c","range","{","0","4e9","}"};
+  auto h = make_shared<ArgumentViewer>(int(sizeof(huge)/sizeof(char const*)),(char**)huge);
+  REQUIRE_THROWS_AS(Sweep(*h),ex::Exception);
+}
+
+SCENARIO("ArgumentViewer fingerprint tests"){
+  auto const fingerprint = [](std::vector<char const*>args){
+    auto a = make_shared<ArgumentViewer>(int(args.size()),(char**)args.data());
+    a->getu32("--width",640);
+    a->getf32v("--color",{0.f,0.f,0.f});
+    a->isPresent("--fast");
+    a->getContext("light")->gets("--name","sun");
+    a->getContext("light")->getsv("--tags",{"a"});
+    return a->getFingerprint();
+  };
+  std::ofstream("fingerprint.txt")<<"--color 1.0 0 light { --name moon }"<<std::endl;
+  auto const base = fingerprint({"test","--width","1024","--color","1","0","0","light","{","--name","moon","}"});
+  REQUIRE(base.toStr().size()==32);
+  REQUIRE(fingerprint({"test","light","{","--name","moon","}","--color","1.0","0.0","0","--width","1024"})==base);
+  REQUIRE(fingerprint({"test","--width","1024","<","fingerprint.txt"})==base);
+  REQUIRE(fingerprint({"test","--width","1024","--color","1","0","0","light","{","--name","moon","--tags","{","a","}","}"})==base);
+  REQUIRE(fingerprint({"test","--width","640","--color","1","0","0","light","{","--name","moon","}"})!=base);
+  REQUIRE(fingerprint({"test","--width","1024","--color","1","0","0","light","{","--name","moon","}","--fast"})!=base);
+  REQUIRE(fingerprint({"test","--width","1024","--color","1","0","0","light","{","--name","sun","}"})!=base);
+  REQUIRE(fingerprint({"test","--color","1","0","0","light","{","--name","moon","}"})==fingerprint({"test","--width","640","--color","1","0","0","light","{","--name","moon","}"}));
+  REQUIRE_THROWS(make_shared<ArgumentViewer>(1,(char**)std::vector<char const*>({"test"}).data())->getContext("light")->getFingerprint());
+  std::remove("fingerprint.txt");
+}
+
+SCENARIO("ArgumentViewer configuration export tests"){
+  auto const registerArguments = [](ArgumentViewer const&a){
+    a.getu32("--width",640);
+    a.getf32v("--color",{0.f,0.f,0.f});
+    a.isPresent("--fast");
+    a.gets("--title");
+    a.getContext("light")->gets("--name","sun");
+    a.getContext("light")->getsv("--tags",{"a"});
+  };
+  std::ofstream("export0.txt")<<"--color 0.1 0.5 light { --tags { x \\} } }"<<std::endl;
+  char const*args[] = {"test","--fast","<","export0.txt","--unknown"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  registerArguments(*a);
+  {
+    std::ofstream file("export1.txt");
+    a->writeConfiguration(file);
+  }
+  std::ofstream("export0.txt")<<"--color 1 1 1"<<std::endl;
+  char const*replayArgs[] = {"test","<","export1.txt"};
+  auto b = make_shared<ArgumentViewer>(3,(char**)replayArgs);
+  registerArguments(*b);
+  REQUIRE(b->validate());
+  REQUIRE(b->getFingerprint()==a->getFingerprint());
+  REQUIRE(b->getf32v("--color",{0.f,0.f,0.f})==std::vector<float>({.1f,.5f,0.f}));
+  REQUIRE(b->getContext("light")->getsv("--tags",{"a"})==std::vector<std::string>({"x","}"}));
+  REQUIRE(b->getContext("light")->gets("--name","sun")=="sun");
+
+  std::stringstream snapshot;
+  a->writeConfiguration(snapshot,ArgumentViewer::SNAPSHOT);
+  auto const data = snapshot.str();
+  std::vector<uint64_t>memory(data.size()/sizeof(uint64_t)+1);
+  std::memcpy(memory.data(),data.data(),data.size());
+  auto frozen = SnapshotViewer::attach(memory.data(),data.size());
+  REQUIRE(frozen->getu32("--width")==640);
+  REQUIRE(frozen->isPresent("--fast"));
+  REQUIRE(!frozen->isPresent("--unknown"));
+  REQUIRE(frozen->getContext("light")->getsv("--tags")==std::vector<std::string>({"x","}"}));
+
+  char const*spaceArgs[] = {"test","--title","two words"};
+  auto c = make_shared<ArgumentViewer>(3,(char**)spaceArgs);
+  registerArguments(*c);
+  std::stringstream ss;
+  REQUIRE_THROWS(c->writeConfiguration(ss));
+  std::remove("export0.txt");
+  std::remove("export1.txt");
+}
+
+SCENARIO("ArgumentViewer trace tests"){
+  std::ofstream("trace.txt")<<"--width 1024"<<std::endl;
+  char const*args[] = {"test","<","trace.txt","light","{","--name","sun","}"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  auto settings = Settings();
+  settings.trace = make_shared<Trace>();
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args,settings);
+  REQUIRE(a->getu32("--width")==1024);
+  REQUIRE(a->getContext("light")->gets("--name")=="sun");
+  REQUIRE(a->validate());
+  a->toStr();
+  REQUIRE(settings.trace->getNofSpans()==8);
+  std::stringstream ss;
+  settings.trace->writeChromeTrace(ss);
+  auto const json = ss.str();
+  REQUIRE(json.find("{\"traceEvents\":[")==0);
+  REQUIRE(json.find("\"name\":\"load file\"")!=std::string::npos);
+  REQUIRE(json.find("\"name\":\"tokenize\"")!=std::string::npos);
+  REQUIRE(json.find("\"key\":\"--width\",\"type\":\"u32\"")!=std::string::npos);
+  REQUIRE(json.find("\"key\":\"--name\",\"type\":\"string\"")!=std::string::npos);
+  REQUIRE(json.find("\"name\":\"validate\"")!=std::string::npos);
+
+  auto ring = Settings();
+  ring.trace = make_shared<Trace>(2);
+  auto b = make_shared<ArgumentViewer>(nofArgs,(char**)args,ring);
+  b->getu32("--width");
+  b->getu32("--height");
+  REQUIRE(ring.trace->getNofSpans()==2);
+  std::stringstream rs;
+  ring.trace->writeChromeTrace(rs);
+  REQUIRE(rs.str().find("--height")!=std::string::npos);
+  REQUIRE(rs.str().find("tokenize")==std::string::npos);
+  std::remove("trace.txt");
+}
+
+SCENARIO("Provenance of arguments"){
+  std::ofstream("provenance0.txt")<<"--width 10\n  --height 20 < provenance1.txt\n"<<std::endl;
+  std::ofstream("provenance1.txt")<<"\n--depth   30 oops\n"<<std::endl;
+  char const*argv[]={"app","--quiet","<","provenance0.txt"};
+  auto a = make_shared<ArgumentViewer>(4,(char**)argv);
+  REQUIRE(a->getNofArguments() == 8);
+  auto const quiet = a->getProvenance(0);
+  REQUIRE(quiet.file   == "");
+  REQUIRE(quiet.column == 1);
+  auto const height = a->getProvenance(3);
+  REQUIRE(height.file   == "provenance0.txt");
+  REQUIRE(height.line   == 2);
+  REQUIRE(height.column == 3);
+  auto const depth = a->getProvenance(6);
+  REQUIRE(depth.file   == "provenance1.txt");
+  REQUIRE(depth.line   == 2);
+  REQUIRE(depth.column == 11);
+  a->isPresent("--quiet");
+  a->geti32("--width");
+  a->geti32("--height");
+  a->geti32("--depth");
+  try{
+    a->validate();
+    REQUIRE(false);
+  }catch(ex::MatchError const&e){
+    REQUIRE(std::string(e.what()).find("in file: provenance1.txt line: 2 column: 14") != std::string::npos);
+  }
+  auto settings = Settings();
+  settings.lazyIncludes = true;
+  auto lazy = make_shared<ArgumentViewer>(4,(char**)argv,settings);
+  REQUIRE(lazy->getProvenance(6).line == 2);
+  REQUIRE(lazy->getProvenance(7).file == "provenance1.txt");
+  std::remove("provenance0.txt");
+  std::remove("provenance1.txt");
+}
+
+SCENARIO("Resource limits"){
+  std::ofstream("limits0.txt")<<"a < limits1.txt"<<std::endl;
+  std::ofstream("limits1.txt")<<"b { c { d } } < limits2.txt"<<std::endl;
+  std::ofstream("limits2.txt")<<"e"<<std::endl;
+  char const*argv[]={"app","x","<","limits0.txt"};
+  auto const readWith = [&](Settings const&settings){
+    return make_shared<ArgumentViewer>(4,(char**)argv,settings);
+  };
+  auto settings = Settings();
+  REQUIRE(readWith(settings)->getNofArguments() == 10);
+  WHEN("limits are not exceeded"){
+    settings.limits.maxTokens       = 16;
+    settings.limits.maxNestingDepth = 2;
+    settings.limits.maxIncludeDepth = 3;
+    settings.limits.maxIncludes     = 3;
+    settings.limits.maxTokenLength  = 11;
+    settings.limits.maxBytes        = 46;
+    REQUIRE(readWith(settings)->getNofArguments() == 10);
+  }
+  WHEN("there are too many tokens"){
+    settings.limits.maxTokens = 15;
+    REQUIRE_THROWS(readWith(settings));
+  }
+  WHEN("contexts are nested too deep"){
+    settings.limits.maxNestingDepth = 1;
+    REQUIRE_THROWS(readWith(settings));
+  }
+  WHEN("files are included too deep"){
+    settings.limits.maxIncludeDepth = 2;
+    REQUIRE_THROWS(readWith(settings));
+  }
+  WHEN("there are too many files"){
+    settings.limits.maxIncludes = 2;
+    REQUIRE_THROWS(readWith(settings));
+  }
+  WHEN("files are too big"){
+    settings.limits.maxBytes = 20;
+    REQUIRE_THROWS(readWith(settings));
+  }
+  WHEN("a token is too long"){
+    settings.limits.maxTokenLength = 10;
+    REQUIRE_THROWS(readWith(settings));
+  }
+  WHEN("lazy include is nested too deep"){
+    settings.lazyIncludes           = true;
+    settings.limits.maxNestingDepth = 1;
+    auto const a = readWith(settings);
+    REQUIRE_THROWS(a->getNofArguments());
+  }
+#if defined(__linux__)
+  WHEN("file system reports size 0 of a big file"){
+    settings.limits.maxBytes = 64;
+    char const*procArgv[]={"app","<","/proc/self/maps"};
+    REQUIRE_THROWS_AS(make_shared<ArgumentViewer>(3,(char**)procArgv,settings),ex::Exception);
+    settings.limits.maxBytes = 1 << 20;
+    REQUIRE(make_shared<ArgumentViewer>(3,(char**)procArgv,settings)->getNofArguments() > 0);
+  }
+#endif
+  std::remove("limits0.txt");
+  std::remove("limits1.txt");
+  std::remove("limits2.txt");
+}
+
+SCENARIO("Deeply nested contexts"){
+  size_t const depth = 1000;
+  std::vector<std::string> arguments = {"app"};
+  for(size_t i=0;i<depth;++i){arguments.push_back("c");arguments.push_back("{");}
+  arguments.push_back("--v");
+  arguments.push_back("7");
+  for(size_t i=0;i<depth;++i)arguments.push_back("}");
+  std::vector<char*>argv;
+  for(auto&x:arguments)argv.push_back(&x[0]);
+  auto a = make_shared<ArgumentViewer>((int)argv.size(),argv.data());
+  //context viewers keep pointer to their parents
+  std::vector<std::shared_ptr<ArgumentViewer>>contexts = {a};
+  for(size_t i=0;i<depth;++i)contexts.push_back(contexts.back()->getContext("c","level"));
+  REQUIRE(contexts.back()->getu32("--v") == 7);
+  REQUIRE(a->validate());
+  auto const help = a->toStr();
+  REQUIRE(std::count(help.begin(),help.end(),'\n') == 2*depth+1);
+  REQUIRE(help.find(std::string(2*depth,' ')+"--v = 0 [u32]") != std::string::npos);
+  REQUIRE(help.substr(help.size()-2) == "}\n");
+  WHEN("the deepest context is not closed"){
+    auto const b = make_shared<ArgumentViewer>((int)argv.size()-1,argv.data());
+    auto context = b->getContext("c");
+    REQUIRE_FALSE(b->diagnose().empty());
+  }
+}
+
+SCENARIO("Deeply nested paths"){
+  //context viewers would copy arguments of every level, paths do not
+  size_t const depth = 100000;
+  std::vector<std::string> arguments = {"app"};
+  for(size_t i=0;i<depth;++i){arguments.push_back("c");arguments.push_back("{");}
+  arguments.push_back("--v");
+  arguments.push_back("7");
+  for(size_t i=0;i<depth;++i)arguments.push_back("}");
+  std::vector<char*>argv;
+  for(auto&x:arguments)argv.push_back(&x[0]);
+  std::string path;
+  for(size_t i=0;i<depth;++i)path += "c/";
+  auto settings = Settings();
+  settings.pathSeparator = '/';
+  auto a = make_shared<ArgumentViewer>((int)argv.size(),argv.data(),settings);
+  REQUIRE(a->getu32(path+"--v") == 7);
+  REQUIRE(a->validate());
+  //the second validation replays the first match
+  REQUIRE(a->diagnose().empty());
+  REQUIRE(a->getFingerprint() == a->getFingerprint());
+  std::stringstream snapshot;
+  a->writeConfiguration(snapshot,ArgumentViewer::SNAPSHOT);
+  REQUIRE(snapshot.str().size() > 0);
+  //formats and matches of all levels are released
+  a.reset();
+}
+
+SCENARIO("Paths of arguments"){
+  char const*argv[]={"app","light","{","info","{","sampling","1","2","3","}","color","1","0","0","}","width","10","a/b","3"};
+  int const argc = sizeof(argv)/sizeof(char const*);
+  auto settings = Settings();
+  settings.pathSeparator = '/';
+  auto a = make_shared<ArgumentViewer>(argc,(char**)argv,settings);
+  REQUIRE(a->geti32v("light/info/sampling") == std::vector<int32_t>({1,2,3}));
+  REQUIRE(a->getf32v("light/color") == std::vector<float>({1.f,0.f,0.f}));
+  REQUIRE(a->getu32("width") == 10);
+  REQUIRE(a->geti32("light/missing/x",5) == 5);
+  REQUIRE(a->geti32("missing/x",4) == 4);
+  REQUIRE(a->getContext("light")->getContext("info")->geti32v("sampling") == std::vector<int32_t>({1,2,3}));
+  REQUIRE(a->getContext("light/info")->geti32v("sampling") == std::vector<int32_t>({1,2,3}));
+  REQUIRE_THROWS(a->getu32("width/x"));
+  a->getContext("missing");
+  a->getContext("light/missing");
+  //a/b is read as argument b of context a
+  REQUIRE_THROWS_AS(a->validate(),ex::MatchError);
+  auto const c = make_shared<ArgumentViewer>(argc-2,(char**)argv,settings);
+  c->geti32v("light/info/sampling");
+  c->getf32v("light/color");
+  c->getu32("width");
+  REQUIRE(c->validate());
+  REQUIRE(a->toStr().find("info { - ") != std::string::npos);
+  WHEN("paths are disabled by default"){
+    auto b = make_shared<ArgumentViewer>(argc,(char**)argv);
+    REQUIRE(b->geti32("a/b") == 3);
+    REQUIRE(b->geti32v("light/info/sampling") == std::vector<int32_t>());
+  }
+}
+
+SCENARIO("Layered configuration"){
+  std::ofstream("layers0.txt")<<"--width 5 --height 6 --depth 7"<<std::endl;
+  std::ofstream("layers1.txt")<<"--depth 8 --extra 1"<<std::endl;
+  setenv("ARGUMENTVIEWER_TEST_HEIGHT","16",1);
+  setenv("ARGUMENTVIEWER_TEST_COLOR","1 0 0",1);
+  char const*argv[]={"app","--width","10"};
+  auto settings = Settings();
+  settings.layers.files             = {"layers0.txt","layers1.txt"};
+  settings.layers.environmentPrefix = "ARGUMENTVIEWER_TEST_";
+  auto const check = [&](std::shared_ptr<ArgumentViewer>const&a){
+    REQUIRE(a->getu32("--width") == 10);
+    REQUIRE(a->getu32("--height") == 16);
+    REQUIRE(a->getu32("--depth") == 7);
+    REQUIRE(a->getu32("--extra") == 1);
+    REQUIRE(a->getf32v("--color") == std::vector<float>({1.f,0.f,0.f}));
+    REQUIRE(a->getLayer("--width") == Layers::COMMAND_LINE);
+    REQUIRE(a->getLayer("--height") == Layers::ENVIRONMENT);
+    REQUIRE(a->getLayer("--depth") == Layers::FILE);
+    REQUIRE(a->getLayer("--missing") == Layers::DEFAULT);
+    REQUIRE(a->validate());
+  };
+  WHEN("files are loaded at construction"){
+    auto const a = make_shared<ArgumentViewer>(3,(char**)argv,settings);
+    check(a);
+    REQUIRE(a->getProvenance(6).file == "ARGUMENTVIEWER_TEST_HEIGHT");
+  }
+  WHEN("files are loaded lazily"){
+    settings.lazyIncludes = true;
+    check(make_shared<ArgumentViewer>(3,(char**)argv,settings));
+  }
+  WHEN("environment variables are mapped by rule"){
+    settings.layers.files.clear();
+    settings.layers.environmentRule = [](std::string const&name){
+      return name == "HEIGHT" ? std::string("-h") : std::string();
+    };
+    auto const a = make_shared<ArgumentViewer>(1,(char**)argv,settings);
+    REQUIRE(a->getNofArguments() == 2);
+    REQUIRE(a->getu32("-h") == 16);
+  }
+  WHEN("values of command line are followed by environment"){
+    settings.layers.files.clear();
+    //variable HEIGHT is written as arguments 4 16
+    settings.layers.environmentRule = [](std::string const&name){
+      return name == "HEIGHT" ? std::string("4") : std::string();
+    };
+    char const*values[]={"app","--scale","1","2","--name"};
+    auto const a = make_shared<ArgumentViewer>(5,(char**)values,settings);
+    REQUIRE(a->getNofArguments() == 6);
+    REQUIRE(a->getu32v("--scale") == std::vector<uint32_t>({1,2}));
+    REQUIRE(a->gets("--name","none") == "none");
+  }
+  WHEN("an argument repeats in one layer"){
+    settings.layers.files = {"layers0.txt","layers0.txt"};
+    char const*repeated[]={"app","--width","10","--width","11"};
+    auto const a = make_shared<ArgumentViewer>(5,(char**)repeated,settings);
+    a->getu32("--width");
+    a->getu32("--height");
+    a->getu32("--depth");
+    a->getf32v("--color");
+    auto const diagnostics = a->diagnose();
+    REQUIRE(diagnostics.size() == 2);
+    REQUIRE(diagnostics[0].index == 2);
+  }
+  unsetenv("ARGUMENTVIEWER_TEST_HEIGHT");
+  unsetenv("ARGUMENTVIEWER_TEST_COLOR");
+  std::remove("layers0.txt");
+  std::remove("layers1.txt");
+}
+
+SCENARIO("JSON argument files"){
+  std::ofstream("config.json")<<R"({
+  "width": 10,
+  "name": "light { 1",
+  "color": [1, 0.5, 0],
+  "tags": ["a", "b c"],
+  "verbose": true,
+  "quiet": false,
+  "missing": null,
+  "light": {"position": [1, 2, 3], "info": {"sampling": [1, 2]}},
+  "passes": [{"samples": 4}, {"samples": 8}],
+  "brace": "{",
+  "text": "tab\t\u00e9\ud83d\ude00"
+})";
+  std::ofstream("invalid.json")<<"{\"a\": [1, }";
+  char const*argv[]={"app","--height","3","<","config.json"};
+  auto settings = Settings();
+  settings.pathSeparator = '/';
+  auto const a = make_shared<ArgumentViewer>(5,(char**)argv,settings);
+  REQUIRE(a->getu32("--height") == 3);
+  REQUIRE(a->getu32("width") == 10);
+  REQUIRE(a->gets("name") == "light { 1");
+  REQUIRE(a->getf32v("color") == std::vector<float>({1.f,.5f,0.f}));
+  REQUIRE(a->getsv("tags") == std::vector<std::string>({"a","b c"}));
+  REQUIRE(a->isPresent("verbose"));
+  REQUIRE(!a->isPresent("quiet"));
+  REQUIRE(!a->isPresent("missing"));
+  REQUIRE(a->getf32v("light/position") == std::vector<float>({1.f,2.f,3.f}));
+  REQUIRE(a->geti32v("light/info/sampling") == std::vector<int32_t>({1,2}));
+  REQUIRE(a->getu32("passes/0/samples") == 4);
+  REQUIRE(a->getu32("passes/1/samples") == 8);
+  REQUIRE(a->gets("brace") == "{");
+  REQUIRE(a->gets("text") == "tab\t\xc3\xa9\xf0\x9f\x98\x80");
+  REQUIRE(a->validate());
+  auto const provenance = a->getProvenance(2);
+  REQUIRE(provenance.file == "config.json");
+  REQUIRE(provenance.line == 2);
+  REQUIRE(provenance.column == 3);
+  char const*invalid[]={"app","<","invalid.json"};
+  REQUIRE_THROWS_AS(make_shared<ArgumentViewer>(3,(char**)invalid),ex::Exception);
+  //mixed arrays would be read as other values
+  std::ofstream("invalid.json")<<"{\"v\": [1, \"a\", true]}";
+  REQUIRE_THROWS_AS(make_shared<ArgumentViewer>(3,(char**)invalid),ex::Exception);
+  std::ofstream("invalid.json")<<"{\"v\": [\"a\", 1]}";
+  REQUIRE_THROWS_AS(make_shared<ArgumentViewer>(3,(char**)invalid),ex::Exception);
+  //values of nested arrays would be mixed with indices: v { 0 1 2 1 3 4 }
+  std::ofstream("invalid.json")<<"{\"v\": [[1, 2], [3, 4]]}";
+  REQUIRE_THROWS_AS(make_shared<ArgumentViewer>(3,(char**)invalid),ex::Exception);
+  std::ofstream("nested.json")<<"{\"v\": [[\"a\", \"b\"], [\"c\"]], \"w\": [{\"x\": [1, 2]}]}";
+  char const*nested[]={"app","<","nested.json"};
+  auto const b = make_shared<ArgumentViewer>(3,(char**)nested,settings);
+  REQUIRE(b->getsv("v/0") == std::vector<std::string>({"a","b"}));
+  REQUIRE(b->getsv("v/1") == std::vector<std::string>({"c"}));
+  REQUIRE(b->getu32v("w/0/x") == std::vector<uint32_t>({1,2}));
+  std::remove("nested.json");
+  std::remove("config.json");
+  std::remove("invalid.json");
+}
+
+struct Seed{
+  uint32_t value;
+  bool operator==(Seed const&other)const{return value==other.value;}
+};
+
+//parser of user value can throw
+template<>struct argumentViewer::ValueTraits<Seed>{
+  static std::string typeName(){return "seed";}
+  static bool parse(std::string const&text,Seed&value){
+    if(text == "random")throw std::runtime_error("random seed is not supported");
+    unsigned v;char rest;
+    if(sscanf(text.c_str(),"%u%c",&v,&rest)!=1)return false;
+    value.value = v;
+    return true;
+  }
+  static std::string toString(Seed const&value){return std::to_string(value.value);}
+};
+
+SCENARIO("Batch parsing of job files"){
+  char const*argv[]={"app"};
+  auto const a = make_shared<ArgumentViewer>(1,(char**)argv);
+  a->getu32("--width");
+  a->getf32v("--color");
+  a->getContext("light")->getf32("intensity");
+  std::vector<std::string>lines;
+  for(size_t i=0;i<1000;++i){
+    if(i%10 == 3)lines.push_back("   # comment");
+    else if(i%10 == 7)lines.push_back("--width "+std::to_string(i)+" --unknown");
+    else lines.push_back("--width "+std::to_string(i)+" --color 1 0 0 light { intensity 2 }");
+  }
+  auto const single   = Batch(*a,1).parseLines(lines);
+  auto const parallel = Batch(*a,4).parseLines(lines);
+  REQUIRE(single.size() == 900);
+  REQUIRE(parallel.size() == single.size());
+  for(size_t i=0;i<parallel.size();++i){
+    REQUIRE(parallel[i].line == single[i].line);
+    REQUIRE(parallel[i].arguments == single[i].arguments);
+    REQUIRE(parallel[i].messages == single[i].messages);
+    bool const unknown = (parallel[i].line-1)%10 == 7;
+    REQUIRE(parallel[i].arguments.at(1) == std::to_string(parallel[i].line-1));
+    REQUIRE(parallel[i].diagnostics.size() == (unknown?1:0));
+  }
+  REQUIRE(parallel[6].line == 8);
+  REQUIRE(parallel[6].diagnostics.at(0).kind == Diagnostic::UNKNOWN_ARGUMENT);
+  REQUIRE(parallel[6].diagnostics.at(0).index == 2);
+  auto const span = Batch(*a,2).parseLines(lines.data()+7,1,8);
+  REQUIRE(span.size() == 1);
+  REQUIRE(span[0].line == 8);
+  std::ofstream("jobs.txt")<<"--width 1\n\n--width x\n";
+  auto const jobs = Batch(*a).parseFile("jobs.txt");
+  REQUIRE(jobs.size() == 2);
+  REQUIRE(jobs[1].line == 3);
+  REQUIRE(jobs[1].diagnostics.size() == 1);
+  REQUIRE_THROWS_AS(Batch(*a).parseFile("missingJobs.txt"),ex::Exception);
+  std::remove("jobs.txt");
+  a->get<Seed>("--seed");
+  std::vector<std::string>seeds;
+  for(size_t i=0;i<300;++i)seeds.push_back(i==100?"--seed random":"--seed "+std::to_string(i));
+  auto const seeded = Batch(*a,4).parseLines(seeds);
+  REQUIRE(seeded.size() == 300);
+  REQUIRE(seeded[100].error == "random seed is not supported");
+  REQUIRE(seeded[99].error.empty());
+  REQUIRE(seeded[101].error.empty());
+  REQUIRE(seeded[101].diagnostics.empty());
+}
+
+SCENARIO("Validation batch and push matcher agree"){
+  setenv("ARGUMENTVIEWER_MATCH_WIDTH","16",1);
+  auto settings = Settings();
+  settings.layers.environmentPrefix = "ARGUMENTVIEWER_MATCH_";
+  settings.layers.environmentRule = [](std::string const&name){
+    return name == "WIDTH" ? std::string("--width") : std::string();
+  };
+  //repeated --width of environment is in lower layer, it is accepted
+  char const*argv[]={"app","--width","10","light","{","--size","1","--size","2","}","--width","11"};
+  auto const a = make_shared<ArgumentViewer>(12,(char**)argv,settings);
+  a->getu32("--width");
+  a->getContext("light")->getu32("--size");
+  auto const validated = a->diagnose();
+  REQUIRE(a->getNofArguments() == 13);
+  //repeated arguments and their values are unknown
+  REQUIRE(validated.size() == 4);
+  auto const batch = Batch(*a,1).parseLines({"--width 10 light { --size 1 --size 2 } --width 11"});
+  REQUIRE(batch.size() == 1);
+  REQUIRE(batch[0].diagnostics.size() == validated.size());
+  for(size_t i=0;i<validated.size();++i){
+    REQUIRE(batch[0].diagnostics[i].kind == Diagnostic::UNKNOWN_ARGUMENT);
+    REQUIRE(validated[i].kind == Diagnostic::UNKNOWN_ARGUMENT);
+    REQUIRE(batch[0].diagnostics[i].index == validated[i].index);
+  }
+  auto m = make_shared<PushMatcher>(*a);
+  std::vector<PushState::Status>statuses;
+  for(size_t i=1;i<12;++i)statuses.push_back(m->push(argv[i]).status);
+  std::vector<PushState::Status>expected(statuses.size(),PushState::ACCEPTED);
+  for(auto const&diagnostic:validated)expected.at(diagnostic.index) = PushState::UNKNOWN_ARGUMENT;
+  REQUIRE(statuses == expected);
+  unsetenv("ARGUMENTVIEWER_MATCH_WIDTH");
+}
+
+SCENARIO("Forwarding arguments to other programs"){
+  char const*argv[]={"app","--width","10","child","{","--depth","3","inner","{","a","}","}","--","--verbose","x y"};
+  auto passthroughSettings = Settings();
+  passthroughSettings.passthroughTerminator = "--";
+  auto const a = make_shared<ArgumentViewer>(15,(char**)argv,passthroughSettings);
+  REQUIRE(a->getu32("--width") == 10);
+  auto const child = a->getContextArgv("child","arguments of helper","helper");
+  REQUIRE(child.size() == 8);
+  REQUIRE(std::string(child[0]) == "helper");
+  REQUIRE(std::string(child[1]) == "--depth");
+  REQUIRE(std::string(child[6]) == "}");
+  REQUIRE(child[7] == nullptr);
+  REQUIRE(a->getContextArgv("child")[1] == child[1]);
+  REQUIRE(a->getNofArguments() == 11);
+  REQUIRE(a->validate());
+  REQUIRE(a->toStr().find("arguments of helper") != std::string::npos);
+  auto const passthrough = a->getPassthroughArgv();
+  REQUIRE(passthrough.size() == 4);
+  REQUIRE(std::string(passthrough[0]) == "app");
+  REQUIRE(std::string(passthrough[2]) == "x y");
+  REQUIRE(passthrough[3] == nullptr);
+  auto const range = a->getArgv(0,2,"helper");
+  REQUIRE(range.size() == 4);
+  REQUIRE(std::string(range[2]) == "10");
+  REQUIRE(a->getArgv(10,100).size() == 3);
+  PushMatcher matcher(*a);
+  for(auto const&token:{"child","{","--width","{","}","}","--width","1"})
+    REQUIRE(matcher.push(token).status == PushState::ACCEPTED);
+  WHEN("passthrough terminator is disabled by default"){
+    auto const b = make_shared<ArgumentViewer>(15,(char**)argv);
+    b->getu32("--width");
+    b->getContextArgv("child");
+    REQUIRE(b->getPassthroughArgv().size() == 2);
+    REQUIRE(!b->diagnose().empty());
+  }
+  WHEN("passthrough terminator is inside of forwarded context"){
+    char const*make[]={"app","child","{","make","--","-j4","}","--width","3"};
+    auto const b = make_shared<ArgumentViewer>(9,(char**)make,passthroughSettings);
+    REQUIRE(b->getu32("--width") == 3);
+    auto const child = b->getContextArgv("child");
+    REQUIRE(child.size() == 5);
+    REQUIRE(std::string(child[2]) == "--");
+    REQUIRE(std::string(child[3]) == "-j4");
+    REQUIRE(b->getPassthroughArgv().size() == 2);
+    REQUIRE(b->validate());
+  }
+}
+
+SCENARIO("Missing argument files"){
+  char const*args[] = {"test","a","{","<","missingInclude.txt","}","b"};
+  int const nofArgs = sizeof(args)/sizeof(char const*);
+  //missing file is empty file by default
+  auto empty = make_shared<ArgumentViewer>(nofArgs,(char**)args);
+  REQUIRE(empty->getNofArguments()==4);
+  REQUIRE(empty->getContext("a")->getNofArguments()==0);
+  auto settings = Settings();
+  settings.missingFilesAreErrors = true;
+  REQUIRE_THROWS_AS(make_shared<ArgumentViewer>(nofArgs,(char**)args,settings),ex::Exception);
+  settings.lazyIncludes = true;
+  auto a = make_shared<ArgumentViewer>(nofArgs,(char**)args,settings);
+  REQUIRE(a->isPresent("b")==true);
+  REQUIRE_THROWS_AS(a->getContext("a")->isPresent("c"),ex::Exception);
+}
+
 SCENARIO("Empty default string parameter"){
   char const*args[] = {"test","a","b","light","{","a","b","c","}","d"};
   int const nofArgs = sizeof(args)/sizeof(char const*);